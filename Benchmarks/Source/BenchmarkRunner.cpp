@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+
+    BenchmarkRunner.cpp
+    Created: 17 Oct 2026 11:02:40am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "BenchmarkRunner.h"
+
+namespace
+{
+    // Plain data, so touching it from inside malloc can't recurse into malloc
+    thread_local juce::int64 threadAllocations = 0;
+}
+
+// Replacing the allocator entry points for the whole benchmark binary costs
+// one thread-local increment per allocation
+#if JUCE_LINUX
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* pointer, size_t size);
+
+    void* malloc(size_t size)
+    {
+        ++threadAllocations;
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size)
+    {
+        ++threadAllocations;
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* pointer, size_t size)
+    {
+        ++threadAllocations;
+        return __libc_realloc(pointer, size);
+    }
+}
+#else
+void* operator new(std::size_t size)
+{
+    ++threadAllocations;
+
+    if (auto* pointer = std::malloc(size == 0 ? 1 : size))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)                  { return operator new(size); }
+void operator delete(void* pointer) noexcept            { std::free(pointer); }
+void operator delete[](void* pointer) noexcept          { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept   { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+#endif
+
+namespace bench
+{
+    double measureMedianNs(const std::function<void()>& body, int warmupRuns, int timedRuns)
+    {
+        for (int i = 0; i < warmupRuns; ++i)
+            body();
+
+        std::vector<double> timings;
+        timings.reserve(static_cast<size_t>(timedRuns));
+
+        for (int i = 0; i < timedRuns; ++i)
+        {
+            const auto start = juce::Time::getHighResolutionTicks();
+            body();
+            const auto end = juce::Time::getHighResolutionTicks();
+
+            timings.push_back(juce::Time::highResolutionTicksToSeconds(end - start) * 1.0e9);
+        }
+
+        std::sort(timings.begin(), timings.end());
+        return timings[timings.size() / 2];
+    }
+
+    LinearFit fitLine(const juce::Array<double>& x, const juce::Array<double>& y)
+    {
+        jassert(x.size() == y.size() && x.size() > 1);
+
+        const double n = static_cast<double>(x.size());
+        double sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0;
+
+        for (int i = 0; i < x.size(); ++i)
+        {
+            sumX += x[i];
+            sumY += y[i];
+            sumXX += x[i] * x[i];
+            sumXY += x[i] * y[i];
+        }
+
+        LinearFit fit;
+        fit.slope = (n * sumXY - sumX * sumY) / (n * sumXX - sumX * sumX);
+        fit.intercept = (sumY - fit.slope * sumX) / n;
+
+        const double meanY = sumY / n;
+        double residual = 0.0, total = 0.0;
+
+        for (int i = 0; i < x.size(); ++i)
+        {
+            const double predicted = fit.slope * x[i] + fit.intercept;
+            residual += (y[i] - predicted) * (y[i] - predicted);
+            total += (y[i] - meanY) * (y[i] - meanY);
+        }
+
+        fit.rSquared = total > 0.0 ? 1.0 - residual / total : 1.0;
+        return fit;
+    }
+
+    int runsForBlock(int blockSize, int samplesPerMeasurement)
+    {
+        return juce::jlimit(30, 4000, samplesPerMeasurement / juce::jmax(1, blockSize));
+    }
+
+    //==============================================================================
+    ScopedCpuPin::ScopedCpuPin(int cpu)
+    {
+        if (cpu < 0 || cpu >= juce::jmin(32, juce::SystemStats::getNumCpus()))
+            return;
+
+        juce::Thread::setCurrentThreadAffinityMask(1u << cpu);
+        pinned = true;
+    }
+
+    ScopedCpuPin::~ScopedCpuPin()
+    {
+        if (! pinned)
+            return;
+
+        const int numCpus = juce::jmin(32, juce::SystemStats::getNumCpus());
+        juce::Thread::setCurrentThreadAffinityMask(numCpus >= 32 ? 0xffffffffu : (1u << numCpus) - 1);
+    }
+
+    //==============================================================================
+    ScopedAllocationCounter::ScopedAllocationCounter()
+        : start(threadAllocations)
+    {
+    }
+
+    juce::int64 ScopedAllocationCounter::getCount() const
+    {
+        return threadAllocations - start;
+    }
+
+    //==============================================================================
+    JsonReport::JsonReport()
+        : root(new juce::DynamicObject())
+    {
+        root->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+        root->setProperty("cpu", juce::SystemStats::getCpuModel());
+        root->setProperty("numCpus", juce::SystemStats::getNumCpus());
+        root->setProperty("os", juce::SystemStats::getOperatingSystemName());
+       #if JUCE_DEBUG
+        root->setProperty("build", "Debug");
+       #else
+        root->setProperty("build", "Release");
+       #endif
+    }
+
+    void JsonReport::setPinnedCpu(int cpu)
+    {
+        root->setProperty("pinnedCpu", cpu);
+    }
+
+    void JsonReport::add(const juce::String& benchmark, const juce::String& unit, double value,
+                         const juce::NamedValueSet& configuration)
+    {
+        auto* result = new juce::DynamicObject();
+        result->setProperty("benchmark", benchmark);
+
+        for (const auto& property : configuration)
+            result->setProperty(property.name, property.value);
+
+        result->setProperty("unit", unit);
+        result->setProperty("value", value);
+        results.add(juce::var(result));
+    }
+
+    bool JsonReport::writeTo(const juce::File& file) const
+    {
+        root->setProperty("results", results);
+        return file.replaceWithText(juce::JSON::toString(juce::var(root.get())));
+    }
+}
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    BenchmarkRunner.h
+    Created: 17 Oct 2026 11:02:40am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace bench
+{
+    // Runs body a few times untimed, then returns the median wall time of a
+    // single call in nanoseconds over timedRuns calls
+    double measureMedianNs(const std::function<void()>& body, int warmupRuns, int timedRuns);
+
+    // Least-squares fit of y = slope * x + intercept
+    struct LinearFit
+    {
+        double slope = 0.0;
+        double intercept = 0.0;
+        double rSquared = 0.0;
+    };
+
+    LinearFit fitLine(const juce::Array<double>& x, const juce::Array<double>& y);
+
+    // Timed runs needed to push roughly samplesPerMeasurement samples through
+    // a benchmark, so small blocks are not dominated by timer resolution
+    int runsForBlock(int blockSize, int samplesPerMeasurement = 1 << 17);
+
+    // Pins the calling thread to one core for its lifetime so repeated runs
+    // see the same cache and clock domain. Threads created meanwhile inherit
+    // the pin on most platforms, so don't start render workers inside one.
+    class ScopedCpuPin
+    {
+    public:
+        explicit ScopedCpuPin(int cpu);
+        ~ScopedCpuPin();
+
+        bool isPinned() const { return pinned; }
+
+    private:
+        bool pinned = false;
+    };
+
+    // Heap allocations made by the calling thread since construction. Counts
+    // malloc, calloc and realloc on Linux, which covers operator new and
+    // JUCE's HeapBlock alike; elsewhere only operator new is seen.
+    class ScopedAllocationCounter
+    {
+    public:
+        ScopedAllocationCounter();
+
+        juce::int64 getCount() const;
+
+    private:
+        juce::int64 start;
+    };
+
+    // Machine-readable results, one entry per measurement, meant to be
+    // diffed between versions
+    class JsonReport
+    {
+    public:
+        JsonReport();
+
+        // Extra key/value pairs describe the configuration (sampleRate,
+        // blockSize, voices, ...)
+        void add(const juce::String& benchmark, const juce::String& unit, double value,
+                 const juce::NamedValueSet& configuration);
+
+        void setPinnedCpu(int cpu);
+        bool writeTo(const juce::File& file) const;
+
+    private:
+        juce::DynamicObject::Ptr root;
+        juce::Array<juce::var> results;
+    };
+}
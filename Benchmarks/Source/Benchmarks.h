@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    Benchmarks.h
+    Created: 17 Oct 2026 11:02:40am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "BenchmarkRunner.h"
+
+// Voice pool: processBlock cost against the number of sounding voices
+void runVoiceScalingBenchmark();
+
+// Stepped vs. ramped glottal and vowel parameters under a continuous sweep
+void runSmoothingBenchmark();
+
+// Voice rendering spread over 1..N cores at 32, 64 and 128 voices, checking the
+// output stays bit-identical to the single threaded render
+void runParallelRenderBenchmark();
+
+// ns/sample of every DSP hot path on its own and of the whole processBlock,
+// swept over block size, sample rate and voice count
+void runMicroBenchmarks(bench::JsonReport& report, bool quick);
+
+// Scalar GlottalOscillator::getNextSample against the SIMD block paths and
+// wavetable playback: speedup per voice, largest deviation from the scalar
+// output, and aliasing of the analytic vs. band-limited pulse
+void runGlottalBlockBenchmark();
+
+// VowelFilter's single-pass in-place formant bank against the old
+// copy-per-formant version
+void runFormantBankBenchmark();
+
+// FormantBank's SIMD state variable filter lanes against biquad sections run
+// one by one, for 3, 5 and 8 formants, and its response against juce::IIRFilter
+void runSimdFormantBankBenchmark();
+
+// Retuning the formant sections from the shared table against computing
+// biquad coefficients with makeBandPass: cost per retune and tuning accuracy
+void runFormantCoefficientBenchmark();
+
+// Vowel filters of many voices held on one vowel against the same voices
+// sweeping continuously through the vowel space
+void runVowelMorphBenchmark();
+
+// Thousands of MIDI events per block through MidiProcessor and processBlock,
+// with and without a scale loaded and as an MPE stream: cost per event and
+// audio thread allocations
+void runMidiStressBenchmark();
+
+// Every .scl/.kbm file under scalaDirectory (or 5000 generated ones if it
+// isn't a directory) read through a stream, parsed from a memory mapping and
+// loaded from a compiled TuningArchive: time, throughput and allocations
+void runScalaParserBenchmark(const juce::File& scalaDirectory);
+
+// getStateInformation/setStateInformation over 100 instances with a tuning
+// loaded, against the parameter tree as XML: time to save, to restore and
+// until the restored tunings are playing, and state size
+void runStateBenchmark();
+
+// Program changes under a held chord, through the preset bank and as the
+// same values set one parameter at a time: cost per switch on the message
+// and audio threads, and the largest jump between output samples
+void runPresetSwitchBenchmark();
+
+// Held voices at 1, 2, 4 and 8x oversampling: cost per block and share of
+// real time, the decimator on its own, its latency, and the inharmonic
+// energy of a high sawtooth and glottal note at each factor
+void runOversamplingBenchmark();
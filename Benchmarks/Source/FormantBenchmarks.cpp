@@ -0,0 +1,406 @@
+/*
+  ==============================================================================
+
+    FormantBenchmarks.cpp
+    Created: 17 Oct 2026 10:31:07pm
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "BenchmarkRunner.h"
+#include "../../Source/Data/VowelFilter.h"
+#include "../../Source/Data/FormantBank.h"
+#include "../../Source/Data/FormantCoefficientTable.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numChannels = 2;
+
+    // The formant bank as VowelFilter used to run it: one juce::IIRFilter per
+    // formant per channel, each fed from its own copy of the input, summed
+    // into a temporary buffer and copied back. Kept here as the baseline.
+    class CopyingFormantBank
+    {
+    public:
+        void prepare(int blockSize)
+        {
+            const float frequencies[] = { 530.0f, 1840.0f, 2480.0f };
+            const float bandwidths[] = { 80.0f, 90.0f, 120.0f };
+            const float gains[] = { 1.5f, 1.2f, 0.6f };
+
+            for (int f = 0; f < 3; ++f)
+            {
+                auto coefficients = juce::IIRCoefficients::makeBandPass(sampleRate, frequencies[f],
+                                                                        frequencies[f] / bandwidths[f]);
+                for (int c = 0; c < 3; ++c)
+                    coefficients.coefficients[c] *= gains[f];
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                    filters[f][channel].setCoefficients(coefficients);
+
+                formantBuffers[f].setSize(numChannels, blockSize);
+            }
+
+            tempBuffer.setSize(numChannels, blockSize);
+        }
+
+        void process(juce::AudioBuffer<float>& buffer)
+        {
+            const int numSamples = buffer.getNumSamples();
+
+            for (int f = 0; f < 3; ++f)
+            {
+                formantBuffers[f].makeCopyOf(buffer, true);
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                    filters[f][channel].processSamples(formantBuffers[f].getWritePointer(channel), numSamples);
+            }
+
+            for (int sample = 0; sample < numSamples; ++sample)
+            {
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    const float filtered = (formantBuffers[0].getSample(channel, sample)
+                                          + formantBuffers[1].getSample(channel, sample)
+                                          + formantBuffers[2].getSample(channel, sample)) * 0.7f;
+                    tempBuffer.setSample(channel, sample, juce::jlimit(-0.95f, 0.95f, filtered));
+                }
+            }
+
+            buffer.makeCopyOf(tempBuffer, true);
+        }
+
+    private:
+        juce::IIRFilter filters[3][numChannels];
+        juce::AudioBuffer<float> formantBuffers[3];
+        juce::AudioBuffer<float> tempBuffer;
+    };
+
+    // Formant frequencies for up to eight sections, bandwidth 10% of centre
+    float formantFrequency(int formant)
+    {
+        const float frequencies[] = { 530.0f, 1840.0f, 2480.0f, 3500.0f, 4500.0f, 5500.0f, 6500.0f, 7500.0f };
+        return frequencies[formant];
+    }
+
+    juce::IIRCoefficients formantCoefficients(int formant)
+    {
+        return juce::IIRCoefficients::makeBandPass(sampleRate, formantFrequency(formant), 10.0);
+    }
+
+    // One biquad section after another per sample, scalar: the arithmetic of
+    // the single-pass bank before it moved to SIMD lanes and state variable
+    // filters
+    class ScalarFormantBank
+    {
+    public:
+        explicit ScalarFormantBank(int formants) : numFormants(formants)
+        {
+            for (int f = 0; f < numFormants; ++f)
+                coefficients[f] = formantCoefficients(f);
+        }
+
+        void process(int channel, float* samples, int numSamples, const float* gains)
+        {
+            auto& z = state[channel];
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float input = samples[i];
+                float sum = 0.0f;
+
+                for (int f = 0; f < numFormants; ++f)
+                {
+                    const float* c = coefficients[f].coefficients;
+                    const float output = c[0] * input + z[f][0];
+                    z[f][0] = c[1] * input - c[3] * output + z[f][1];
+                    z[f][1] = c[2] * input - c[4] * output;
+                    sum += output;
+                }
+
+                samples[i] = juce::jlimit(-0.95f, 0.95f, sum * gains[i]);
+            }
+        }
+
+    private:
+        int numFormants;
+        juce::IIRCoefficients coefficients[FormantBank::maxFormants];
+        float state[numChannels][FormantBank::maxFormants][2] = {};
+    };
+
+    struct SimdFormantBank
+    {
+        explicit SimdFormantBank(int formants)
+        {
+            bank.prepare(numChannels, formants);
+
+            // The same bandpass as formantCoefficients(), in SVF form
+            for (int f = 0; f < formants; ++f)
+                bank.setFormant(f, static_cast<float>(std::tan(juce::MathConstants<double>::pi * formantFrequency(f) / sampleRate)),
+                                0.1f, 1.0f);
+        }
+
+        void process(int channel, float* samples, int numSamples, const float* gains)
+        {
+            bank.process(channel, samples, numSamples, gains);
+        }
+
+        FormantBank bank;
+    };
+
+    // Stereo block through a bank that takes one channel at a time
+    template <typename Bank>
+    double timeChannelBank(Bank& bank, int blockSize)
+    {
+        juce::AudioBuffer<float> input(numChannels, blockSize), buffer(numChannels, blockSize);
+        juce::Random random(1234);
+        std::vector<float> gains(static_cast<size_t>(blockSize), 0.2f);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < blockSize; ++i)
+                input.setSample(channel, i, random.nextFloat() * 0.5f - 0.25f);
+
+        const int runs = bench::runsForBlock(blockSize);
+
+        return bench::measureMedianNs([&]
+        {
+            buffer.makeCopyOf(input, true);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                bank.process(channel, buffer.getWritePointer(channel), blockSize, gains.data());
+        }, runs / 10, runs) / blockSize;
+    }
+
+    // Largest difference between the SIMD bank's impulse response and the sum
+    // of one juce::IIRFilter per formant running makeBandPass coefficients
+    float measureResponseError(int formants)
+    {
+        constexpr int length = 4096;
+        SimdFormantBank simd(formants);
+        juce::IIRFilter reference[FormantBank::maxFormants];
+        std::vector<float> expected(length, 0.0f), actual(length, 0.0f), scratch(length);
+        std::vector<float> unity(length, 1.0f);
+
+        for (int f = 0; f < formants; ++f)
+        {
+            reference[f].setCoefficients(formantCoefficients(f));
+            std::fill(scratch.begin(), scratch.end(), 0.0f);
+            scratch[0] = 0.5f;
+            reference[f].processSamples(scratch.data(), length);
+
+            for (int i = 0; i < length; ++i)
+                expected[static_cast<size_t>(i)] += scratch[static_cast<size_t>(i)];
+        }
+
+        actual[0] = 0.5f;
+        simd.process(0, actual.data(), length, unity.data());
+
+        float maxError = 0.0f;
+
+        for (int i = 0; i < length; ++i)
+            maxError = juce::jmax(maxError, std::abs(juce::jlimit(-0.95f, 0.95f, expected[static_cast<size_t>(i)])
+                                                     - actual[static_cast<size_t>(i)]));
+
+        return maxError;
+    }
+
+    // Worst tuning error of the interpolated table over the formant range at
+    // one sample rate, in cents: the frequency its g actually tunes a section to
+    double measureTableError(const FormantCoefficientTable& table, double rate)
+    {
+        double maxErrorCents = 0.0;
+
+        for (double frequency = 50.0; frequency < rate * 0.4; frequency *= 1.0011)
+        {
+            const double g = table.lookup(static_cast<float>(std::log2(frequency / rate)));
+            const double tuned = std::atan(g) / juce::MathConstants<double>::pi * rate;
+            maxErrorCents = juce::jmax(maxErrorCents, std::abs(1200.0 * std::log2(tuned / frequency)));
+        }
+
+        return maxErrorCents;
+    }
+
+    template <typename Bank>
+    double timeBank(Bank& bank, int blockSize)
+    {
+        juce::AudioBuffer<float> input(numChannels, blockSize), buffer(numChannels, blockSize);
+        juce::Random random(1234);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < blockSize; ++i)
+                input.setSample(channel, i, random.nextFloat() * 0.5f - 0.25f);
+
+        const int runs = bench::runsForBlock(blockSize);
+
+        return bench::measureMedianNs([&]
+        {
+            buffer.makeCopyOf(input, true);
+            bank.process(buffer);
+        }, runs / 10, runs) / blockSize;
+    }
+}
+
+void runFormantBankBenchmark()
+{
+    const int blockSizes[] = { 32, 128, 512, 2048 };
+
+    std::cout << "Formant bank per voice, stereo (" << sampleRate << " Hz, ns/sample)" << std::endl;
+    std::cout << "  block    copying   in place   speedup" << std::endl;
+
+    for (auto blockSize : blockSizes)
+    {
+        CopyingFormantBank baseline;
+        baseline.prepare(blockSize);
+
+        VowelFilter filter;
+        filter.prepareToPlay(sampleRate, blockSize, numChannels);
+
+        const double before = timeBank(baseline, blockSize);
+        const double after = timeBank(filter, blockSize);
+
+        std::cout << "  " << juce::String(blockSize).paddedLeft(' ', 5)
+                  << juce::String(before, 2).paddedLeft(' ', 11)
+                  << juce::String(after, 2).paddedLeft(' ', 11)
+                  << juce::String(before / after, 2).paddedLeft(' ', 9) << "x" << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+void runSimdFormantBankBenchmark()
+{
+    constexpr int blockSize = 512;
+
+    std::cout << "SIMD formant bank, " << FormantBank::lanes << " lanes, stereo (" << sampleRate << " Hz, "
+              << blockSize << " samples, ns/sample)" << std::endl;
+    std::cout << "  formants     scalar       SIMD   speedup   max error vs IIRFilter" << std::endl;
+
+    for (int formants : { 3, 5, 8 })
+    {
+        ScalarFormantBank scalar(formants);
+        SimdFormantBank simd(formants);
+
+        const double before = timeChannelBank(scalar, blockSize);
+        const double after = timeChannelBank(simd, blockSize);
+
+        std::cout << "  " << juce::String(formants).paddedLeft(' ', 8)
+                  << juce::String(before, 2).paddedLeft(' ', 11)
+                  << juce::String(after, 2).paddedLeft(' ', 11)
+                  << juce::String(before / after, 2).paddedLeft(' ', 9) << "x"
+                  << juce::String(measureResponseError(formants), 8).paddedLeft(' ', 25) << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+void runFormantCoefficientBenchmark()
+{
+    juce::SharedResourcePointer<FormantCoefficientTable> table;
+    FormantBank bank;
+    bank.prepare(1, 3);
+
+    // Three formants per retune, as VowelFilter::updateFilters does it
+    const float frequencies[] = { 530.0f, 1840.0f, 2480.0f };
+    const float qs[] = { 6.6f, 8.0f, 8.0f };
+    float log2Frequencies[3];
+
+    for (int f = 0; f < 3; ++f)
+        log2Frequencies[f] = std::log2(frequencies[f]);
+
+    std::cout << "Formant retune, 3 formants (ns/retune)" << std::endl;
+    std::cout << "      rate  makeBandPass  SVF table   speedup   max tuning error (cents)" << std::endl;
+
+    // The last two are 8x oversampling at 48k and 96k
+    for (double rate : { 44100.0, 48000.0, 96000.0, 192000.0, 384000.0, 768000.0 })
+    {
+        juce::IIRCoefficients results[3];
+        float detune = 1.0f;
+
+        // The biquad bank's retune
+        const double before = bench::measureMedianNs([&]
+        {
+            detune = detune > 1.5f ? 1.0f : detune * 1.001f;
+
+            for (int f = 0; f < 3; ++f)
+                results[f] = juce::IIRCoefficients::makeBandPass(rate, frequencies[f] * detune, qs[f]);
+        }, 1000, 20000);
+
+        const float log2Rate = static_cast<float>(std::log2(rate));
+        float log2Detune = 0.0f;
+
+        // What VowelFilter does now: one table lookup and a division per section
+        const double after = bench::measureMedianNs([&]
+        {
+            log2Detune = log2Detune > 0.58f ? 0.0f : log2Detune + 0.0014f;
+
+            for (int f = 0; f < 3; ++f)
+                bank.setFormant(f, table->lookup(log2Frequencies[f] + log2Detune - log2Rate), 1.0f / qs[f], 1.0f);
+        }, 1000, 20000);
+
+        std::cout << "  " << juce::String(rate / 1000.0, 1).paddedLeft(' ', 7) << "k"
+                  << juce::String(before, 1).paddedLeft(' ', 14)
+                  << juce::String(after, 1).paddedLeft(' ', 11)
+                  << juce::String(before / after, 2).paddedLeft(' ', 9) << "x"
+                  << juce::String(measureTableError(*table, rate), 4).paddedLeft(' ', 27) << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+void runVowelMorphBenchmark()
+{
+    constexpr int numVoices = 128;
+    constexpr int blockSize = 512;
+
+    std::cout << "Vowel filters for " << numVoices << " mono voices (" << sampleRate << " Hz, "
+              << blockSize << " samples, ns/sample/voice)" << std::endl;
+    std::cout << "      static    sweeping   ratio" << std::endl;
+
+    std::vector<std::unique_ptr<VowelFilter>> filters;
+
+    for (int v = 0; v < numVoices; ++v)
+    {
+        filters.push_back(std::make_unique<VowelFilter>());
+        filters.back()->prepareToPlay(sampleRate, blockSize, 1);
+    }
+
+    juce::AudioBuffer<float> input(1, blockSize), buffer(1, blockSize);
+    juce::Random random(1234);
+
+    for (int i = 0; i < blockSize; ++i)
+        input.setSample(0, i, random.nextFloat() * 0.5f - 0.25f);
+
+    const auto timeFilters = [&] (bool sweep)
+    {
+        float phase = 0.0f;
+
+        return bench::measureMedianNs([&]
+        {
+            // A slow loop around the vowel space, a different spot per voice
+            phase += 0.01f;
+
+            for (int v = 0; v < numVoices; ++v)
+            {
+                if (sweep)
+                {
+                    const float angle = phase + v * 0.05f;
+                    filters[static_cast<size_t>(v)]->setVowelPosition({ 0.5f + 0.5f * std::sin(angle), 0.5f + 0.5f * std::cos(angle) });
+                }
+
+                buffer.makeCopyOf(input, true);
+                filters[static_cast<size_t>(v)]->process(buffer);
+            }
+        }, 20, 400) / (blockSize * numVoices);
+    };
+
+    const double still = timeFilters(false);
+    const double moving = timeFilters(true);
+
+    std::cout << juce::String(still, 2).paddedLeft(' ', 12)
+              << juce::String(moving, 2).paddedLeft(' ', 12)
+              << juce::String(moving / still, 2).paddedLeft(' ', 8) << "x" << std::endl
+              << std::endl;
+}
@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 11:02:40am
+    Author:  zerocase
+
+    Console benchmarks for the ISODRONE DSP engine. Build the Release
+    configuration; numbers from Debug builds are meaningless.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "Benchmarks.h"
+#include "../../Source/Data/GlottalWavetable.h"
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h"))
+    {
+        std::cout << "usage: ISODRONEBenchmarks [--suite all|micro|voices|smoothing|oscillator|formant|midi|scala|state|presets|oversampling|parallel]" << std::endl
+                  << "                          [--json <file>] [--cpu <n>] [--quick] [--scala-dir <dir>]" << std::endl
+                  << std::endl
+                  << "  --json <file>  write the micro benchmark results as JSON" << std::endl
+                  << "  --cpu <n>      core to pin single threaded suites to (default 0, -1 = don't pin)" << std::endl
+                  << "  --quick        fewer block sizes, sample rates and voice counts" << std::endl
+                  << "  --scala-dir    .scl/.kbm files for the scala suite, e.g. the Scala archive" << std::endl
+                  << "                 (default: 5000 generated files)" << std::endl;
+        return 0;
+    }
+
+    const auto suite = args.containsOption("--suite") ? args.getValueForOption("--suite") : juce::String("all");
+    const int cpu = args.containsOption("--cpu") ? args.getValueForOption("--cpu").getIntValue() : 0;
+    const bool quick = args.containsOption("--quick");
+    const auto runSuite = [&suite] (const char* name) { return suite == "all" || suite == name; };
+
+    bench::JsonReport report;
+
+    // Oscillators fall back to the analytic pulse until the shared tables are
+    // built, so wait for them to keep the numbers stable
+    juce::SharedResourcePointer<GlottalWavetableCache> wavetableCache;
+    wavetableCache->waitUntilBuilt(30000);
+
+    {
+        bench::ScopedCpuPin pin(cpu);
+
+        if (pin.isPinned())
+        {
+            report.setPinnedCpu(cpu);
+            std::cout << "Pinned to CPU " << cpu << std::endl << std::endl;
+        }
+
+        if (runSuite("micro"))
+            runMicroBenchmarks(report, quick);
+
+        if (runSuite("voices"))
+            runVoiceScalingBenchmark();
+
+        if (runSuite("smoothing"))
+            runSmoothingBenchmark();
+
+        if (runSuite("oscillator"))
+            runGlottalBlockBenchmark();
+
+        if (runSuite("formant"))
+        {
+            runFormantBankBenchmark();
+            runSimdFormantBankBenchmark();
+            runFormantCoefficientBenchmark();
+            runVowelMorphBenchmark();
+        }
+
+        if (runSuite("midi"))
+            runMidiStressBenchmark();
+
+        if (runSuite("scala"))
+        {
+            const auto scalaDirectory = args.containsOption("--scala-dir")
+                ? juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--scala-dir"))
+                : juce::File();
+
+            runScalaParserBenchmark(scalaDirectory);
+        }
+
+        if (runSuite("state"))
+            runStateBenchmark();
+
+        if (runSuite("presets"))
+            runPresetSwitchBenchmark();
+
+        if (runSuite("oversampling"))
+            runOversamplingBenchmark();
+    }
+
+    // Needs every core, so it runs unpinned
+    if (runSuite("parallel"))
+        runParallelRenderBenchmark();
+
+    if (args.containsOption("--json"))
+    {
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--json"));
+
+        if (! report.writeTo(file))
+        {
+            std::cerr << "could not write " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        std::cout << "Results written to " << file.getFullPathName() << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,349 @@
+/*
+  ==============================================================================
+
+    MicroBenchmarks.cpp
+    Created: 17 Oct 2026 8:04:37pm
+    Author:  zerocase
+
+    ns/sample for each DSP hot path on its own, swept over block size and
+    sample rate, plus the whole processBlock swept over voice count.
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "BenchmarkRunner.h"
+#include "../../Source/PluginProcessor.h"
+#include "../../Source/IsoSound.h"
+#include "../../Source/Data/ADSRData.h"
+
+namespace
+{
+    struct Sweep
+    {
+        juce::Array<int> blockSizes;
+        juce::Array<double> sampleRates;
+        juce::Array<int> voiceCounts;
+    };
+
+    Sweep makeSweep(bool quick)
+    {
+        if (quick)
+            return { { 64, 512, 4096 }, { 44100.0, 48000.0, 192000.0 }, { 1, 32, 128 } };
+
+        return { { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 },
+                 { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 },
+                 { 1, 8, 32, 64, 128 } };
+    }
+
+    juce::NamedValueSet configuration(double sampleRate, int blockSize, int voices = 1)
+    {
+        juce::NamedValueSet values;
+        values.set("sampleRate", sampleRate);
+        values.set("blockSize", blockSize);
+        values.set("voices", voices);
+        return values;
+    }
+
+    void fillWithNoise(juce::AudioBuffer<float>& buffer, juce::Random& random)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample(channel, i, random.nextFloat() * 0.5f - 0.25f);
+    }
+
+    //==============================================================================
+    double timeGlottalSample(double sampleRate, int blockSize)
+    {
+        GlottalOscillator osc;
+        osc.prepare({ sampleRate, static_cast<juce::uint32>(blockSize), 1 });
+        osc.setFrequency(110.0f);
+
+        std::vector<float> output(static_cast<size_t>(blockSize));
+        const int runs = bench::runsForBlock(blockSize);
+
+        return bench::measureMedianNs([&]
+        {
+            for (auto& sample : output)
+                sample = osc.getNextSample();
+        }, runs / 10, runs) / blockSize;
+    }
+
+    double timeGlottalBlock(double sampleRate, int blockSize)
+    {
+        GlottalOscillator osc;
+        osc.prepare({ sampleRate, static_cast<juce::uint32>(blockSize), 1 });
+        osc.setFrequency(110.0f);
+
+        std::vector<float> output(static_cast<size_t>(blockSize));
+        const int runs = bench::runsForBlock(blockSize);
+
+        return bench::measureMedianNs([&]
+        {
+            osc.process(output.data(), blockSize);
+        }, runs / 10, runs) / blockSize;
+    }
+
+    double timeOscBlock(int waveType, double sampleRate, int blockSize)
+    {
+        juce::dsp::ProcessSpec spec { sampleRate, static_cast<juce::uint32>(blockSize), 2 };
+        OscData osc;
+        osc.prepareToPlay(spec);
+        osc.setWaveType(waveType);
+        osc.setWaveFrequency(110.0f);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::dsp::AudioBlock<float> block(buffer);
+        const int runs = bench::runsForBlock(blockSize);
+
+        return bench::measureMedianNs([&]
+        {
+            osc.getNextAudioBlock(block);
+        }, runs / 10, runs) / blockSize;
+    }
+
+    double timeVowelProcess(double sampleRate, int blockSize)
+    {
+        // One channel, as a voice runs it
+        VowelFilter filter;
+        filter.prepareToPlay(sampleRate, blockSize, 1);
+
+        juce::AudioBuffer<float> input(1, blockSize), buffer(1, blockSize);
+        juce::Random random(1234);
+        fillWithNoise(input, random);
+        const int runs = bench::runsForBlock(blockSize);
+
+        // The copy is part of the timing but costs next to nothing next to the filters
+        return bench::measureMedianNs([&]
+        {
+            buffer.makeCopyOf(input, true);
+            filter.process(buffer);
+        }, runs / 10, runs) / blockSize;
+    }
+
+    // updateFilters() is private; a formant shift change is the cheapest public
+    // way to trigger exactly one rebuild
+    double timeVowelUpdate(double sampleRate)
+    {
+        VowelFilter filter;
+        filter.prepareToPlay(sampleRate, 512, 1);
+        bool toggle = false;
+
+        return bench::measureMedianNs([&]
+        {
+            toggle = ! toggle;
+            filter.setFormantShift(toggle ? 1.1f : 0.9f);
+        }, 100, 2000);
+    }
+
+    double timeEnvelope(double sampleRate, int blockSize)
+    {
+        ADSRData adsr;
+        adsr.setSampleRate(sampleRate);
+        adsr.updateADSR(0.1f, 0.1f, 1.0f, 0.4f);
+        adsr.noteOn();
+
+        juce::AudioBuffer<float> buffer(1, blockSize);
+        buffer.clear();
+        const int runs = bench::runsForBlock(blockSize);
+
+        return bench::measureMedianNs([&]
+        {
+            adsr.applyEnvelopeToBuffer(buffer, 0, blockSize);
+        }, runs / 10, runs) / blockSize;
+    }
+
+    double timeVoiceRender(double sampleRate, int blockSize)
+    {
+        MidiProcessor midiProcessor;
+        ParameterSnapshot parameters;
+
+        // A bare Synthesiser owns the voice so the note is started the normal way
+        juce::Synthesiser synth;
+        synth.addSound(new IsoSound());
+        auto* voice = static_cast<IsoVoice*>(synth.addVoice(new IsoVoice()));
+        synth.setCurrentPlaybackSampleRate(sampleRate);
+
+        voice->setMidiProcessor(&midiProcessor);
+        voice->setParameterSnapshot(&parameters);
+        voice->prepareToPlay(sampleRate, blockSize, 2);
+        synth.noteOn(1, 48, 0.8f);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        const int runs = bench::runsForBlock(blockSize);
+
+        return bench::measureMedianNs([&]
+        {
+            buffer.clear();
+            voice->renderNextBlock(buffer, 0, blockSize);
+        }, runs / 10, runs) / blockSize;
+    }
+
+    double timeProcessBlock(double sampleRate, int blockSize, int numVoices)
+    {
+        ISODRONEAudioProcessor processor;
+        processor.setVoiceCount(juce::jmax(IsoSynthesiser::minVoices, numVoices));
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> buffer(processor.getTotalNumOutputChannels(), blockSize);
+        juce::MidiBuffer midi;
+
+        for (int v = 0; v < numVoices; ++v)
+            midi.addEvent(juce::MidiMessage::noteOn(1 + v / 64, 36 + v % 64, 0.8f), 0);
+
+        buffer.clear();
+        processor.processBlock(buffer, midi);
+        midi.clear();
+
+        const int runs = bench::runsForBlock(blockSize * numVoices);
+
+        const double ns = bench::measureMedianNs([&]
+        {
+            buffer.clear();
+            processor.processBlock(buffer, midi);
+        }, runs / 10, runs);
+
+        processor.releaseResources();
+        return ns / blockSize;
+    }
+
+    //==============================================================================
+    void printHeader(const juce::String& title, const juce::String& unit = "ns/sample")
+    {
+        std::cout << "  " << title << " (" << unit << ")" << std::endl;
+    }
+
+    void printRow(const juce::String& label, const juce::Array<double>& values)
+    {
+        std::cout << "    " << label.paddedRight(' ', 10);
+
+        for (auto value : values)
+            std::cout << juce::String(value, 2).paddedLeft(' ', 10);
+
+        std::cout << std::endl;
+    }
+
+    void printColumns(const juce::String& corner, const juce::StringArray& columns)
+    {
+        std::cout << "    " << corner.paddedRight(' ', 10);
+
+        for (auto& column : columns)
+            std::cout << column.paddedLeft(' ', 10);
+
+        std::cout << std::endl;
+    }
+
+    // Runs a per-sample benchmark over every block size and sample rate,
+    // printing a table of rates x block sizes
+    void sweepBlockAndRate(bench::JsonReport& report, const Sweep& sweep, const juce::String& name,
+                           const std::function<double(double, int)>& benchmark)
+    {
+        printHeader(name);
+
+        juce::StringArray columns;
+
+        for (auto blockSize : sweep.blockSizes)
+            columns.add(juce::String(blockSize));
+
+        printColumns("rate", columns);
+
+        for (auto sampleRate : sweep.sampleRates)
+        {
+            juce::Array<double> row;
+
+            for (auto blockSize : sweep.blockSizes)
+            {
+                const double ns = benchmark(sampleRate, blockSize);
+                report.add(name, "ns/sample", ns, configuration(sampleRate, blockSize));
+                row.add(ns);
+            }
+
+            printRow(juce::String(sampleRate / 1000.0, 1) + "k", row);
+        }
+    }
+}
+
+void runMicroBenchmarks(bench::JsonReport& report, bool quick)
+{
+    const auto sweep = makeSweep(quick);
+
+    std::cout << "DSP hot paths" << std::endl;
+
+    sweepBlockAndRate(report, sweep, "GlottalOscillator::getNextSample", timeGlottalSample);
+    sweepBlockAndRate(report, sweep, "GlottalOscillator::process", timeGlottalBlock);
+    sweepBlockAndRate(report, sweep, "OscData::getNextAudioBlock (sawtooth)",
+                      [] (double rate, int block) { return timeOscBlock(OscData::SAWTOOTH, rate, block); });
+    sweepBlockAndRate(report, sweep, "OscData::getNextAudioBlock (glottal)",
+                      [] (double rate, int block) { return timeOscBlock(OscData::GLOTTAL, rate, block); });
+    sweepBlockAndRate(report, sweep, "VowelFilter::process", timeVowelProcess);
+    sweepBlockAndRate(report, sweep, "ADSRData::applyEnvelopeToBuffer", timeEnvelope);
+    sweepBlockAndRate(report, sweep, "IsoVoice::renderNextBlock", timeVoiceRender);
+
+    // A rebuild happens once per parameter change, not per sample
+    printHeader("VowelFilter::updateFilters", "ns/call");
+    juce::Array<double> updates;
+
+    for (auto sampleRate : sweep.sampleRates)
+    {
+        const double ns = timeVowelUpdate(sampleRate);
+        report.add("VowelFilter::updateFilters", "ns/call", ns, configuration(sampleRate, 0));
+        updates.add(ns);
+    }
+
+    juce::StringArray rates;
+
+    for (auto sampleRate : sweep.sampleRates)
+        rates.add(juce::String(sampleRate / 1000.0, 1) + "k");
+
+    printColumns("", rates);
+    printRow("ns/call", updates);
+
+    // Whole plugin: voices against block size at 48k, then against sample rate at 512
+    const juce::String processName = "ISODRONEAudioProcessor::processBlock";
+    printHeader(processName + ", 48 kHz");
+
+    juce::StringArray blockColumns;
+
+    for (auto blockSize : sweep.blockSizes)
+        blockColumns.add(juce::String(blockSize));
+
+    printColumns("voices", blockColumns);
+
+    for (auto voices : sweep.voiceCounts)
+    {
+        juce::Array<double> row;
+
+        for (auto blockSize : sweep.blockSizes)
+        {
+            const double ns = timeProcessBlock(48000.0, blockSize, voices);
+            report.add(processName, "ns/sample", ns, configuration(48000.0, blockSize, voices));
+            row.add(ns);
+        }
+
+        printRow(juce::String(voices), row);
+    }
+
+    printHeader(processName + ", 512 samples");
+    printColumns("voices", rates);
+
+    for (auto voices : sweep.voiceCounts)
+    {
+        juce::Array<double> row;
+
+        for (auto sampleRate : sweep.sampleRates)
+        {
+            const double ns = timeProcessBlock(sampleRate, 512, voices);
+
+            // 48k/512 is already in the table above
+            if (sampleRate != 48000.0 || ! sweep.blockSizes.contains(512))
+                report.add(processName, "ns/sample", ns, configuration(sampleRate, 512, voices));
+
+            row.add(ns);
+        }
+
+        printRow(juce::String(voices), row);
+    }
+
+    std::cout << std::endl;
+}
@@ -0,0 +1,216 @@
+/*
+  ==============================================================================
+
+    MidiBenchmarks.cpp
+    Created: 18 Oct 2026 2:21:15am
+    Author:  zerocase
+
+    Dense MIDI through MidiProcessor and the whole processBlock: cost per
+    event, and heap allocations on the audio thread, which must be zero once
+    the processor is prepared. Includes an MPE stream where every note has
+    its own bend, pressure and timbre.
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "BenchmarkRunner.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+    constexpr int measuredBlocks = 200;
+
+    // 19 equal divisions of the octave: every key needs a bend
+    juce::File writeTestScale()
+    {
+        juce::String text = "! stress.scl\n19-EDO\n19\n";
+
+        for (int step = 1; step <= 19; ++step)
+            text << juce::String(1200.0 * step / 19.0, 5) << "\n";
+
+        auto file = juce::File::createTempFile(".scl");
+        file.replaceWithText(text);
+        return file;
+    }
+
+    // Note on, encoder CC, matching note off, page CC, repeated across all
+    // sixteen channels and spread evenly over the block
+    juce::MidiBuffer makeDenseBlock(int numEvents)
+    {
+        juce::MidiBuffer midi;
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            const int position = static_cast<int>(static_cast<juce::int64>(i) * blockSize / numEvents);
+            const int channel = 1 + (i / 4) % 16;
+            const int note = 24 + (i / 4) % 72;
+
+            switch (i % 4)
+            {
+                case 0:  midi.addEvent(juce::MidiMessage::noteOn(channel, note, static_cast<juce::uint8>(100)), position); break;
+                case 1:  midi.addEvent(juce::MidiMessage::controllerEvent(channel, 20 + (i / 4) % 17, i % 128), position); break;
+                case 2:  midi.addEvent(juce::MidiMessage::noteOff(channel, note), position); break;
+                default: midi.addEvent(juce::MidiMessage::controllerEvent(channel, 119, (i / 4) % 4), position); break;
+            }
+        }
+
+        return midi;
+    }
+
+    // The same density as an MPE controller would send it: each note on its
+    // own member channel of a 15 channel lower zone, with a bend, pressure and
+    // timbre update before its note-off
+    juce::MidiBuffer makeMpeBlock(int numEvents)
+    {
+        juce::MidiBuffer midi;
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            const int position = static_cast<int>(static_cast<juce::int64>(i) * blockSize / numEvents);
+            const int channel = 2 + (i / 5) % 15;
+            const int note = 24 + (i / 5) % 72;
+
+            switch (i % 5)
+            {
+                case 0:  midi.addEvent(juce::MidiMessage::noteOn(channel, note, static_cast<juce::uint8>(100)), position); break;
+                case 1:  midi.addEvent(juce::MidiMessage::pitchWheel(channel, 8192 + (i * 37) % 2048), position); break;
+                case 2:  midi.addEvent(juce::MidiMessage::channelPressureChange(channel, i % 128), position); break;
+                case 3:  midi.addEvent(juce::MidiMessage::controllerEvent(channel, 74, (i * 3) % 128), position); break;
+                default: midi.addEvent(juce::MidiMessage::noteOff(channel, note), position); break;
+            }
+        }
+
+        return midi;
+    }
+
+    struct Result
+    {
+        double nsPerEvent = 0.0;
+        juce::int64 firstBlockAllocations = 0;
+        juce::int64 steadyAllocations = 0;
+    };
+
+    Result runMidiProcessor(const juce::MidiBuffer& input)
+    {
+        MidiProcessor midiProcessor;
+        Result result;
+
+        {
+            bench::ScopedAllocationCounter counter;
+            midiProcessor.process(input);
+            result.firstBlockAllocations = counter.getCount();
+        }
+
+        // Counted apart from the timing, which allocates for its own bookkeeping
+        {
+            bench::ScopedAllocationCounter counter;
+
+            for (int block = 0; block < measuredBlocks; ++block)
+                midiProcessor.process(input);
+
+            result.steadyAllocations = counter.getCount();
+        }
+
+        const double ns = bench::measureMedianNs([&] { midiProcessor.process(input); }, 0, measuredBlocks);
+        result.nsPerEvent = ns / juce::jmax(1, input.getNumEvents());
+        return result;
+    }
+
+    Result runProcessBlock(const juce::MidiBuffer& input, const juce::File& scale, bool mpe)
+    {
+        ISODRONEAudioProcessor processor;
+
+        if (scale != juce::File())
+            processor.midiProcessor.loadScalaFile(scale);
+
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> buffer(processor.getTotalNumOutputChannels(), blockSize);
+
+        // The zone is set up the way a controller does it, once, up front
+        if (mpe)
+        {
+            auto configuration = juce::MPEMessages::setLowerZone(15);
+            processor.processBlock(buffer, configuration);
+        }
+
+        juce::MidiBuffer midi;
+        midi.ensureSize(input.data.size());
+
+        // The host hands over a fresh buffer every block; copying into one
+        // with enough room doesn't allocate
+        auto runBlock = [&]
+        {
+            midi.clear();
+            midi.addEvents(input, 0, -1, 0);
+            buffer.clear();
+            processor.processBlock(buffer, midi);
+        };
+
+        Result result;
+
+        {
+            bench::ScopedAllocationCounter counter;
+            runBlock();
+            result.firstBlockAllocations = counter.getCount();
+        }
+
+        {
+            bench::ScopedAllocationCounter counter;
+
+            for (int block = 0; block < measuredBlocks; ++block)
+                runBlock();
+
+            result.steadyAllocations = counter.getCount();
+        }
+
+        const double ns = bench::measureMedianNs(runBlock, 0, measuredBlocks);
+        result.nsPerEvent = ns / juce::jmax(1, input.getNumEvents());
+
+        processor.releaseResources();
+        return result;
+    }
+
+    void printResult(const juce::String& label, int numEvents, const Result& result)
+    {
+        std::cout << "    " << label.paddedRight(' ', 22)
+                  << juce::String(numEvents).paddedLeft(' ', 8)
+                  << juce::String(result.nsPerEvent, 1).paddedLeft(' ', 12)
+                  << juce::String(result.firstBlockAllocations).paddedLeft(' ', 10)
+                  << juce::String(result.steadyAllocations).paddedLeft(' ', 10)
+                  << (result.steadyAllocations == 0 ? "" : "  ALLOCATES") << std::endl;
+    }
+}
+
+void runMidiStressBenchmark()
+{
+    std::cout << "Dense MIDI, " << blockSize << " samples/block, " << measuredBlocks << " blocks" << std::endl;
+    std::cout << "    " << juce::String("path").paddedRight(' ', 22)
+              << juce::String("events").paddedLeft(' ', 8)
+              << juce::String("ns/event").paddedLeft(' ', 12)
+              << juce::String("1st allocs").paddedLeft(' ', 10)
+              << juce::String("allocs").paddedLeft(' ', 10) << std::endl;
+
+    const auto scale = writeTestScale();
+
+    for (auto numEvents : { 256, 1024, 4096, 16384 })
+    {
+        const auto input = makeDenseBlock(numEvents);
+        const auto mpeInput = makeMpeBlock(numEvents);
+
+        printResult("MidiProcessor", numEvents, runMidiProcessor(input));
+        printResult("processBlock", numEvents, runProcessBlock(input, {}, false));
+        printResult("processBlock (19-EDO)", numEvents, runProcessBlock(input, scale, false));
+        printResult("processBlock (MPE)", numEvents, runProcessBlock(mpeInput, {}, true));
+        printResult("processBlock (MPE, 19)", numEvents, runProcessBlock(mpeInput, scale, true));
+    }
+
+    scale.deleteFile();
+
+    std::cout << "  1st allocs: the first block after prepareToPlay. allocs: every block after." << std::endl
+              << std::endl;
+}
@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+    OscillatorBenchmarks.cpp
+    Created: 17 Oct 2026 9:12:50pm
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "BenchmarkRunner.h"
+#include "../../Source/Data/OscData.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+
+    struct Shape
+    {
+        float openQuotient, asymmetry, tenseness;
+    };
+
+    void prepareOscillator(GlottalOscillator& osc, const Shape& shape, float frequency, float breathiness,
+                           bool useWavetables = false)
+    {
+        osc.setWavetablesEnabled(useWavetables);
+        osc.setSmoothingTime(0.0);
+        osc.prepare({ sampleRate, static_cast<juce::uint32>(blockSize), 1 });
+        osc.setFrequency(frequency);
+        osc.setOpenQuotient(shape.openQuotient);
+        osc.setAsymmetryCoeff(shape.asymmetry);
+        osc.setBreathiness(breathiness);
+        osc.setTenseness(shape.tenseness);
+    }
+
+    // Largest difference from getNextSample() over one second, noise off
+    float measureError(const Shape& shape, float frequency, bool multiVoice)
+    {
+        GlottalOscillator reference, blockOsc, other;
+        prepareOscillator(reference, shape, frequency, 0.0f);
+        prepareOscillator(blockOsc, shape, frequency, 0.0f);
+        prepareOscillator(other, shape, frequency * 1.5f, 0.0f);
+
+        std::vector<float> expected(blockSize), actual(blockSize), scratch(blockSize);
+        GlottalOscillator* oscillators[] = { &blockOsc, &other };
+        float* outputs[] = { actual.data(), scratch.data() };
+        float maxError = 0.0f;
+
+        for (int block = 0; block < static_cast<int>(sampleRate) / blockSize; ++block)
+        {
+            for (auto& sample : expected)
+                sample = reference.getNextSample();
+
+            if (multiVoice)
+                GlottalOscillator::processVoices(oscillators, outputs, 2, blockSize);
+            else
+                blockOsc.process(actual.data(), blockSize);
+
+            for (int i = 0; i < blockSize; ++i)
+                maxError = juce::jmax(maxError, std::abs(expected[i] - actual[i]));
+        }
+
+        return maxError;
+    }
+}
+
+namespace
+{
+    // Share of the spectrum (in dB) that is not on a harmonic of the note.
+    // The note sits exactly on an FFT bin so every real partial is one line.
+    float measureAliasingDb(bool useWavetables, float targetFrequency)
+    {
+        constexpr int fftOrder = 16;
+        constexpr int fftSize = 1 << fftOrder;
+        const int bin = juce::roundToInt(targetFrequency * fftSize / sampleRate);
+        const float frequency = static_cast<float>(bin * sampleRate / fftSize);
+
+        GlottalOscillator osc;
+        prepareOscillator(osc, { 0.6f, 0.7f, 0.8f }, frequency, 0.0f, useWavetables);
+
+        std::vector<float> data(static_cast<size_t>(fftSize) * 2, 0.0f);
+        juce::dsp::WindowingFunction<float> window(static_cast<size_t>(fftSize),
+                                                   juce::dsp::WindowingFunction<float>::blackmanHarris, false);
+
+        for (int i = 0; i < fftSize; ++i)
+            data[static_cast<size_t>(i)] = osc.getNextSample();
+
+        window.multiplyWithWindowingTable(data.data(), static_cast<size_t>(fftSize));
+        juce::dsp::FFT(fftOrder).performFrequencyOnlyForwardTransform(data.data());
+
+        double harmonic = 0.0, other = 0.0;
+
+        for (int k = 1; k < fftSize / 2; ++k)
+        {
+            const double energy = static_cast<double>(data[static_cast<size_t>(k)]) * data[static_cast<size_t>(k)];
+            const int distance = std::abs(k - bin * juce::roundToInt(static_cast<float>(k) / bin));
+
+            if (distance <= 4)
+                harmonic += energy;
+            else
+                other += energy;
+        }
+
+        return static_cast<float>(10.0 * std::log10((other + 1.0e-30) / (harmonic + other + 1.0e-30)));
+    }
+}
+
+void runGlottalBlockBenchmark()
+{
+    // Table playback needs the shared bank
+    juce::SharedResourcePointer<GlottalWavetableCache> wavetableCache;
+    wavetableCache->waitUntilBuilt(30000);
+
+    const int lanes = static_cast<int>(juce::dsp::SIMDRegister<float>::SIMDNumElements);
+    const Shape shape { 0.6f, 0.7f, 0.8f };
+
+    std::cout << "Glottal oscillator, scalar vs block (" << sampleRate << " Hz, " << blockSize
+              << " samples, " << lanes << " SIMD lanes)" << std::endl;
+
+    const double scalar = [&]
+    {
+        GlottalOscillator osc;
+        prepareOscillator(osc, shape, 110.0f, 0.1f);
+        std::vector<float> output(blockSize);
+
+        return bench::measureMedianNs([&]
+        {
+            for (auto& sample : output)
+                sample = osc.getNextSample();
+        }, 50, 1000) / blockSize;
+    }();
+
+    const double block = [&]
+    {
+        GlottalOscillator osc;
+        prepareOscillator(osc, shape, 110.0f, 0.1f);
+        std::vector<float> output(blockSize);
+
+        return bench::measureMedianNs([&]
+        {
+            osc.process(output.data(), blockSize);
+        }, 50, 1000) / blockSize;
+    }();
+
+    const double table = [&]
+    {
+        GlottalOscillator osc;
+        prepareOscillator(osc, shape, 110.0f, 0.1f, true);
+        std::vector<float> output(blockSize);
+
+        return bench::measureMedianNs([&]
+        {
+            osc.process(output.data(), blockSize);
+        }, 50, 1000) / blockSize;
+    }();
+
+    const double multiVoice = [&]
+    {
+        const int numVoices = lanes * 4;
+        std::vector<GlottalOscillator> oscs(static_cast<size_t>(numVoices));
+        juce::HeapBlock<float> storage(static_cast<size_t>(numVoices * blockSize));
+        juce::Array<GlottalOscillator*> oscillators;
+        juce::Array<float*> outputs;
+
+        for (int v = 0; v < numVoices; ++v)
+        {
+            prepareOscillator(oscs[static_cast<size_t>(v)], shape, 55.0f * (1.0f + 0.1f * v), 0.1f);
+            oscillators.add(&oscs[static_cast<size_t>(v)]);
+            outputs.add(storage.get() + v * blockSize);
+        }
+
+        return bench::measureMedianNs([&]
+        {
+            GlottalOscillator::processVoices(oscillators.getRawDataPointer(), outputs.getRawDataPointer(),
+                                             numVoices, blockSize);
+        }, 50, 1000) / (blockSize * numVoices);
+    }();
+
+    std::cout << "  getNextSample         " << juce::String(scalar, 2).paddedLeft(' ', 8) << " ns/sample" << std::endl
+              << "  process               " << juce::String(block, 2).paddedLeft(' ', 8) << " ns/sample  "
+              << juce::String(scalar / block, 1) << "x" << std::endl
+              << "  processVoices         " << juce::String(multiVoice, 2).paddedLeft(' ', 8) << " ns/sample/voice  "
+              << juce::String(scalar / multiVoice, 1) << "x" << std::endl
+              << "  wavetable process     " << juce::String(table, 2).paddedLeft(' ', 8) << " ns/sample  "
+              << juce::String(scalar / table, 1) << "x" << std::endl;
+
+    std::cout << "  aliasing (non-harmonic energy):" << std::endl;
+
+    for (auto frequency : { 220.0f, 880.0f, 3520.0f })
+        std::cout << "    " << juce::String(frequency, 0).paddedLeft(' ', 5) << " Hz  analytic "
+                  << juce::String(measureAliasingDb(false, frequency), 1) << " dB, wavetable "
+                  << juce::String(measureAliasingDb(true, frequency), 1) << " dB" << std::endl;
+
+    // Error against the scalar reference over the whole parameter range
+    const Shape shapes[] = { { 0.3f, 0.1f, 0.0f }, { 0.6f, 0.7f, 0.8f }, { 0.7f, 2.0f, 1.0f } };
+    float blockError = 0.0f, voicesError = 0.0f;
+
+    for (const auto& s : shapes)
+    {
+        for (auto frequency : { 55.0f, 220.0f, 1760.0f })
+        {
+            blockError = juce::jmax(blockError, measureError(s, frequency, false));
+            voicesError = juce::jmax(voicesError, measureError(s, frequency, true));
+        }
+    }
+
+    std::cout << "  max error vs scalar:  process " << juce::String(blockError, 8)
+              << ", processVoices " << juce::String(voicesError, 8) << std::endl << std::endl;
+}
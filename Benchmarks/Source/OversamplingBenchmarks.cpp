@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+    OversamplingBenchmarks.cpp
+    Created: 18 Oct 2026 7:31:52am
+    Author:  zerocase
+
+    What each oversampling factor costs and buys. Cost: a block of held
+    voices through processBlock at 1, 2, 4 and 8x, and the decimator on its
+    own. Benefit: a high sawtooth and glottal note rendered at each factor,
+    with the energy that isn't on a harmonic of the note (aliasing folded
+    back from above Nyquist) measured against the energy that is.
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "BenchmarkRunner.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+    constexpr int numVoices = 16;
+    constexpr int fftOrder = 15;
+    const int factors[] = { 1, 2, 4, 8 };
+
+    std::unique_ptr<ISODRONEAudioProcessor> createProcessor(int factor, int waveType)
+    {
+        auto processor = std::make_unique<ISODRONEAudioProcessor>();
+        auto* wave = processor->apvts.getParameter("OSC1WAVETYPE");
+        wave->setValueNotifyingHost(wave->convertTo0to1(static_cast<float>(waveType)));
+        processor->setOversamplingFactor(factor);
+        processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+        return processor;
+    }
+
+    double timeVoices(int factor)
+    {
+        auto processor = createProcessor(factor, 1);
+        juce::AudioBuffer<float> buffer(processor->getTotalNumOutputChannels(), blockSize);
+        juce::MidiBuffer midi;
+
+        for (int v = 0; v < numVoices; ++v)
+            midi.addEvent(juce::MidiMessage::noteOn(1, 36 + 3 * v, 0.8f), 0);
+
+        buffer.clear();
+        processor->processBlock(buffer, midi);
+        midi.clear();
+
+        return bench::measureMedianNs([&]
+        {
+            buffer.clear();
+            processor->processBlock(buffer, midi);
+        }, 50, 400);
+    }
+
+    double timeDecimator(int factor, int numChannels)
+    {
+        HalfBandDecimator decimator;
+        decimator.prepare(factor, numChannels, blockSize);
+
+        juce::AudioBuffer<float> input(numChannels, blockSize * factor), output(numChannels, blockSize);
+        juce::Random random(2026);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < input.getNumSamples(); ++i)
+                input.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        return bench::measureMedianNs([&]
+        {
+            output.clear();
+            decimator.process(input, output, 0, blockSize);
+        }, 100, 1000);
+    }
+
+    // Inharmonic energy relative to the harmonics, in dB, of one note held
+    // long enough for the envelope to settle
+    double measureAliasing(int factor, int waveType, int note)
+    {
+        auto processor = createProcessor(factor, waveType);
+        const int fftSize = 1 << fftOrder;
+        const int settleBlocks = 40;
+
+        juce::AudioBuffer<float> buffer(processor->getTotalNumOutputChannels(), blockSize);
+        juce::MidiBuffer midi;
+        midi.addEvent(juce::MidiMessage::noteOn(1, note, 0.8f), 0);
+
+        std::vector<float> samples;
+        samples.reserve(static_cast<size_t>(fftSize));
+
+        for (int block = 0; static_cast<int>(samples.size()) < fftSize; ++block)
+        {
+            buffer.clear();
+            processor->processBlock(buffer, midi);
+            midi.clear();
+
+            if (block >= settleBlocks)
+                for (int i = 0; i < blockSize && static_cast<int>(samples.size()) < fftSize; ++i)
+                    samples.push_back(buffer.getSample(0, i));
+        }
+
+        const double frequency = processor->midiProcessor.midiNoteToFrequency(note);
+
+        juce::dsp::WindowingFunction<float> window(static_cast<size_t>(fftSize), juce::dsp::WindowingFunction<float>::blackmanHarris, false);
+        window.multiplyWithWindowingTable(samples.data(), static_cast<size_t>(fftSize));
+
+        std::vector<float> spectrum(static_cast<size_t>(2 * fftSize), 0.0f);
+        std::copy(samples.begin(), samples.end(), spectrum.begin());
+        juce::dsp::FFT(fftOrder).performFrequencyOnlyForwardTransform(spectrum.data());
+
+        // Bins within a few of a harmonic count as the note; the window's
+        // main lobe is 4 bins either side
+        const double binWidth = sampleRate / fftSize;
+        double harmonic = 0.0, inharmonic = 0.0;
+
+        for (int bin = 1; bin < fftSize / 2; ++bin)
+        {
+            const double binFrequency = bin * binWidth;
+            const double nearest = frequency * std::round(binFrequency / frequency);
+            const double power = static_cast<double>(spectrum[static_cast<size_t>(bin)]) * spectrum[static_cast<size_t>(bin)];
+
+            if (nearest > 0.0 && std::abs(binFrequency - nearest) <= 5.0 * binWidth)
+                harmonic += power;
+            else
+                inharmonic += power;
+        }
+
+        return 10.0 * std::log10((inharmonic + 1.0e-30) / (harmonic + 1.0e-30));
+    }
+}
+
+void runOversamplingBenchmark()
+{
+    const double blockUs = 1.0e6 * blockSize / sampleRate;
+
+    std::cout << "Oversampling, " << numVoices << " glottal voices at " << sampleRate << " Hz, "
+              << blockSize << " samples/block" << std::endl;
+    std::cout << "    " << juce::String("factor").paddedRight(' ', 8)
+              << juce::String("us/block").paddedLeft(' ', 10)
+              << juce::String("% of rt").paddedLeft(' ', 10)
+              << juce::String("decim us").paddedLeft(' ', 10)
+              << juce::String("latency").paddedLeft(' ', 10)
+              << juce::String("saw alias").paddedLeft(' ', 11)
+              << juce::String("glot alias").paddedLeft(' ', 11) << std::endl;
+
+    for (const int factor : factors)
+    {
+        const double us = timeVoices(factor) / 1000.0;
+        const double decimatorUs = timeDecimator(factor, 2) / 1000.0;
+
+        HalfBandDecimator decimator;
+        decimator.prepare(factor, 2, blockSize);
+
+        std::cout << "    " << (juce::String(factor) + "x").paddedRight(' ', 8)
+                  << juce::String(us, 1).paddedLeft(' ', 10)
+                  << juce::String(100.0 * us / blockUs, 2).paddedLeft(' ', 10)
+                  << juce::String(decimatorUs, 2).paddedLeft(' ', 10)
+                  << juce::String(decimator.getLatency(), 3).paddedLeft(' ', 10)
+                  << (juce::String(measureAliasing(factor, 0, 96), 1) + " dB").paddedLeft(' ', 11)
+                  << (juce::String(measureAliasing(factor, 1, 96), 1) + " dB").paddedLeft(' ', 11)
+                  << std::endl;
+    }
+
+    std::cout << "  decim us is the stereo decimator alone; latency is in samples at the host" << std::endl
+              << "  rate. Alias columns: energy off the harmonics of MIDI note 96 against the" << std::endl
+              << "  energy on them, lower is cleaner." << std::endl
+              << std::endl;
+}
@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+
+    ParallelBenchmarks.cpp
+    Created: 17 Oct 2026 6:58:02pm
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "BenchmarkRunner.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+
+    juce::MidiMessage droneNoteOn(int voiceIndex)
+    {
+        return juce::MidiMessage::noteOn(1 + voiceIndex / 64, 36 + voiceIndex % 64, 0.8f);
+    }
+
+    std::unique_ptr<ISODRONEAudioProcessor> makeProcessor(int numVoices, int numThreads)
+    {
+        auto processor = std::make_unique<ISODRONEAudioProcessor>();
+        processor->setVoiceCount(numVoices);
+        processor->setRenderThreads(numThreads);
+
+        // Breath noise would make two runs differ regardless of threading:
+        // switch it off before the voices are prepared, and fix the seed so
+        // the few ms the source takes to ramp down from its default repeat too
+        processor->midiProcessor.breathiness = 0.0f;
+        processor->setNoiseSeed(2026);
+        processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+        return processor;
+    }
+
+    void startDrones(ISODRONEAudioProcessor& processor, juce::AudioBuffer<float>& buffer, int numVoices)
+    {
+        juce::MidiBuffer midi;
+
+        for (int v = 0; v < numVoices; ++v)
+            midi.addEvent(droneNoteOn(v), 0);
+
+        buffer.clear();
+        processor.processBlock(buffer, midi);
+    }
+
+    // Renders the same note sequence single threaded and with numThreads and
+    // requires the outputs to match exactly
+    bool isBitIdentical(int numVoices, int numThreads)
+    {
+        auto reference = makeProcessor(numVoices, 1);
+        auto parallel = makeProcessor(numVoices, numThreads);
+
+        juce::AudioBuffer<float> a(reference->getTotalNumOutputChannels(), blockSize);
+        juce::AudioBuffer<float> b(parallel->getTotalNumOutputChannels(), blockSize);
+        startDrones(*reference, a, numVoices);
+        startDrones(*parallel, b, numVoices);
+
+        juce::MidiBuffer midi;
+
+        for (int block = 0; block < 32; ++block)
+        {
+            // Release half of the drones part way through so tails and voice
+            // shutdown are covered as well
+            if (block == 16)
+                for (int v = 0; v < numVoices; v += 2)
+                    midi.addEvent(juce::MidiMessage::noteOff(1 + v / 64, 36 + v % 64), 100);
+
+            juce::MidiBuffer midiCopy(midi);
+            a.clear();
+            b.clear();
+            reference->processBlock(a, midi);
+            parallel->processBlock(b, midiCopy);
+            midi.clear();
+
+            for (int ch = 0; ch < a.getNumChannels(); ++ch)
+                if (std::memcmp(a.getReadPointer(ch), b.getReadPointer(ch), sizeof(float) * blockSize) != 0)
+                    return false;
+        }
+
+        return true;
+    }
+}
+
+void runParallelRenderBenchmark()
+{
+    const int voiceCounts[] = { 32, 64, 128 };
+    const int numCores = juce::SystemStats::getNumCpus();
+
+    std::cout << "Parallel voice rendering (" << sampleRate << " Hz, " << blockSize << " samples, "
+              << numCores << " cores)" << std::endl;
+    std::cout << "  voices  threads    us/block    speedup   bit-identical" << std::endl;
+
+    for (auto numVoices : voiceCounts)
+    {
+        double singleThreaded = 0.0;
+
+        for (int threads = 1; threads <= numCores; ++threads)
+        {
+            auto processor = makeProcessor(numVoices, threads);
+            juce::AudioBuffer<float> buffer(processor->getTotalNumOutputChannels(), blockSize);
+            startDrones(*processor, buffer, numVoices);
+
+            juce::MidiBuffer midi;
+            const double ns = bench::measureMedianNs([&]
+            {
+                buffer.clear();
+                processor->processBlock(buffer, midi);
+            }, 50, 400);
+
+            if (threads == 1)
+                singleThreaded = ns;
+
+            const bool identical = threads == 1 || isBitIdentical(numVoices, threads);
+
+            std::cout << "  " << juce::String(numVoices).paddedLeft(' ', 6)
+                      << juce::String(threads).paddedLeft(' ', 9)
+                      << juce::String(ns / 1000.0, 2).paddedLeft(' ', 12)
+                      << juce::String(singleThreaded / ns, 2).paddedLeft(' ', 10) << "x"
+                      << (identical ? "   yes" : "   NO") << std::endl;
+
+            processor->releaseResources();
+        }
+    }
+
+    std::cout << std::endl;
+}
@@ -0,0 +1,227 @@
+/*
+  ==============================================================================
+
+    PresetBenchmarks.cpp
+    Created: 18 Oct 2026 6:40:17am
+    Author:  zerocase
+
+    Program switching under sustained notes. A bank of presets alternating
+    between the sawtooth and glottal sources, different envelopes and
+    tunings is loaded into the shared PresetBank, then a chord is held while
+    the program changes every few blocks. Measured: what a switch costs on
+    the message and audio threads, and the largest jump between consecutive
+    output samples, against the same values set one parameter at a time.
+    The program changes are run again with 64 sample blocks, shorter than
+    the voices' switch crossfade, which then renders ahead of the block.
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "BenchmarkRunner.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr int numPresets = 32;
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 256;
+    constexpr int smallBlockSize = 64;  // Under the 5 ms crossfade at 48 kHz
+    constexpr int blocksPerProgram = 20;
+    constexpr int numSwitches = 64;
+
+    // Presets written the way the plugin saves them: every one a different
+    // source, envelope, vowel and equal temperament
+    void writePresets(const juce::File& directory)
+    {
+        juce::Random random(2026);
+
+        for (int p = 0; p < numPresets; ++p)
+        {
+            ISODRONEAudioProcessor processor;
+            processor.setNonRealtime(true);
+
+            auto set = [&processor] (const char* parameterID, float value)
+            {
+                auto* parameter = processor.apvts.getParameter(parameterID);
+                parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+            };
+
+            set("OSC1WAVETYPE", static_cast<float>(p % 2));
+            set("SUSTAIN", 0.3f + 0.7f * random.nextFloat());
+            set("STEREOSPREAD", random.nextFloat());
+            processor.midiProcessor.vowelX = random.nextFloat();
+            processor.midiProcessor.vowelY = random.nextFloat();
+            processor.midiProcessor.breathiness = random.nextFloat();
+
+            const int divisions = 5 + random.nextInt(30);
+            juce::String scale = "! preset.scl\n" + juce::String(divisions) + "-EDO\n" + juce::String(divisions) + "\n";
+
+            for (int step = 1; step <= divisions; ++step)
+                scale << juce::String(1200.0 * step / divisions, 5) << "\n";
+
+            juce::TemporaryFile scaleFile(".scl");
+            scaleFile.getFile().replaceWithText(scale);
+            processor.midiProcessor.loadScalaFile(scaleFile.getFile());
+
+            juce::MemoryBlock state;
+            processor.getStateInformation(state);
+            directory.getChildFile("Preset " + juce::String(p).paddedLeft('0', 2) + PresetBank::fileExtension)
+                     .replaceWithData(state.getData(), state.getSize());
+        }
+    }
+
+    struct Result
+    {
+        double switchUs = 0.0;          // Message thread, per switch
+        double blockUs = 0.0;           // Median audio block
+        double switchBlockUs = 0.0;     // Median block right after a switch
+        float largestStep = 0.0f;       // Between consecutive output samples
+        float steadyLargestStep = 0.0f; // Same, away from switches
+    };
+
+    // Holds a chord and switches program every blocksPerProgram blocks,
+    // either through setCurrentProgram or by setting each parameter the
+    // preset holds on its own
+    Result runSwitches(const PresetBank::Presets& presets, bool asProgram, int samplesPerBlock)
+    {
+        ISODRONEAudioProcessor processor;
+        processor.setRateAndBufferSizeDetails(sampleRate, samplesPerBlock);
+        processor.prepareToPlay(sampleRate, samplesPerBlock);
+        processor.setCurrentProgram(0);
+        processor.midiProcessor.waitForPendingLoads(10000);
+
+        juce::AudioBuffer<float> buffer(processor.getTotalNumOutputChannels(), samplesPerBlock);
+        juce::MidiBuffer midi;
+
+        for (const int note : { 48, 55, 60, 64, 67 })
+            midi.addEvent(juce::MidiMessage::noteOn(1, note, 0.8f), 0);
+
+        // The voices' 5 ms crossfade, plus the block the switch lands in
+        const int blocksAfterSwitch = 1 + (juce::roundToInt(sampleRate * 0.005) + samplesPerBlock - 1) / samplesPerBlock;
+        std::vector<double> blockTimes, switchBlockTimes, switchTimes;
+        Result result;
+        float previousSample = 0.0f;
+
+        for (int block = 0; block < numSwitches * blocksPerProgram; ++block)
+        {
+            const bool switches = block > 0 && block % blocksPerProgram == 0;
+
+            if (switches)
+            {
+                const auto& state = *presets[static_cast<size_t>(block / blocksPerProgram) % presets.size()].state;
+                const double start = juce::Time::getMillisecondCounterHiRes();
+
+                if (asProgram)
+                {
+                    processor.setCurrentProgram(static_cast<int>((block / blocksPerProgram) % static_cast<int>(presets.size())));
+                }
+                else
+                {
+                    for (const auto& saved : state.parameters)
+                        if (auto* parameter = processor.apvts.getParameter(saved.parameterID))
+                            parameter->setValueNotifyingHost(saved.value);
+
+                    processor.midiProcessor.setControllerValues(state.controllers);
+                }
+
+                switchTimes.push_back(1000.0 * (juce::Time::getMillisecondCounterHiRes() - start));
+            }
+
+            buffer.clear();
+            const double start = juce::Time::getMillisecondCounterHiRes();
+            processor.processBlock(buffer, midi);
+            const double elapsed = 1000.0 * (juce::Time::getMillisecondCounterHiRes() - start);
+            midi.clear();
+
+            // Once the chord has settled, look at every sample-to-sample step
+            if (block < blocksPerProgram / 2)
+            {
+                previousSample = buffer.getSample(0, samplesPerBlock - 1);
+                continue;
+            }
+
+            (switches ? switchBlockTimes : blockTimes).push_back(elapsed);
+            const bool nearSwitch = block % blocksPerProgram < blocksAfterSwitch;
+
+            for (int i = 0; i < samplesPerBlock; ++i)
+            {
+                const float sample = buffer.getSample(0, i);
+                const float step = std::abs(sample - previousSample);
+                previousSample = sample;
+
+                result.largestStep = juce::jmax(result.largestStep, step);
+
+                if (! nearSwitch)
+                    result.steadyLargestStep = juce::jmax(result.steadyLargestStep, step);
+            }
+        }
+
+        auto median = [] (std::vector<double> times)
+        {
+            if (times.empty())
+                return 0.0;
+
+            std::nth_element(times.begin(), times.begin() + static_cast<long>(times.size() / 2), times.end());
+            return times[times.size() / 2];
+        };
+
+        result.switchUs = median(switchTimes);
+        result.blockUs = median(blockTimes);
+        result.switchBlockUs = median(switchBlockTimes);
+        return result;
+    }
+
+    void printResult(const juce::String& label, const Result& result)
+    {
+        std::cout << "    " << label.paddedRight(' ', 20)
+                  << juce::String(result.switchUs, 1).paddedLeft(' ', 12)
+                  << juce::String(result.blockUs, 1).paddedLeft(' ', 10)
+                  << juce::String(result.switchBlockUs, 1).paddedLeft(' ', 12)
+                  << juce::String(result.largestStep, 4).paddedLeft(' ', 12)
+                  << juce::String(result.steadyLargestStep, 4).paddedLeft(' ', 12)
+                  << std::endl;
+    }
+}
+
+void runPresetSwitchBenchmark()
+{
+    const auto directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                               .getNonexistentChildFile("ISODRONEPresets", {}, false);
+    directory.createDirectory();
+    writePresets(directory);
+
+    juce::SharedResourcePointer<PresetBank> presetBank;
+    const auto previousDirectory = presetBank->getDirectory();
+
+    const double loadStart = juce::Time::getMillisecondCounterHiRes();
+    presetBank->setDirectory(directory);
+    presetBank->waitForScan(30000);
+    const double loadMs = juce::Time::getMillisecondCounterHiRes() - loadStart;
+
+    const auto presets = presetBank->getPresets();
+
+    std::cout << "Preset switching, " << presets->size() << " presets loaded in " << juce::String(loadMs, 1)
+              << " ms, 5 note chord, a switch every " << blocksPerProgram << " blocks of " << blockSize << std::endl;
+    std::cout << "    " << juce::String("switch").paddedRight(' ', 20)
+              << juce::String("us/switch").paddedLeft(' ', 12)
+              << juce::String("us/block").paddedLeft(' ', 10)
+              << juce::String("switch blk").paddedLeft(' ', 12)
+              << juce::String("max step").paddedLeft(' ', 12)
+              << juce::String("steady step").paddedLeft(' ', 12) << std::endl;
+
+    if (! presets->empty())
+    {
+        printResult("program change", runSwitches(*presets, true, blockSize));
+        printResult("one by one", runSwitches(*presets, false, blockSize));
+        printResult("program, " + juce::String(smallBlockSize) + " blk", runSwitches(*presets, true, smallBlockSize));
+    }
+
+    std::cout << "  max step is the largest jump between consecutive samples anywhere; steady" << std::endl
+              << "  step leaves out the blocks covering each switch's crossfade." << std::endl
+              << std::endl;
+
+    presetBank->setDirectory(previousDirectory);
+    presetBank->waitForScan(30000);
+    directory.deleteRecursively();
+}
@@ -0,0 +1,236 @@
+/*
+  ==============================================================================
+
+    ScalaBenchmarks.cpp
+    Created: 18 Oct 2026 4:02:36am
+    Author:  zerocase
+
+    Loading a whole tuning archive: Scala text read through a stream, text
+    parsed straight out of a memory mapping, and the same files compiled to
+    one TuningArchive. Runs over a directory of .scl/.kbm files, such as the
+    Scala archive, or over a generated set of the same size.
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "BenchmarkRunner.h"
+#include "../../Source/Data/TuningArchive.h"
+
+namespace
+{
+    constexpr int generatedFiles = 5000;
+    constexpr int runs = 5;
+
+    // Roughly the Scala archive's mix: mostly scales of 5 to 72 notes, in
+    // cents or ratios, with comment headers, and a tenth keyboard mappings
+    void generateArchive(const juce::File& directory)
+    {
+        juce::Random random(2026);
+
+        for (int f = 0; f < generatedFiles; ++f)
+        {
+            juce::String text;
+
+            if (f % 10 == 9)
+            {
+                const int mapSize = 1 + random.nextInt(24);
+                text << "! map" << f << ".kbm\n!\n" << mapSize << "\n0\n127\n60\n69\n440.0\n" << mapSize << "\n";
+
+                for (int key = 0; key < mapSize; ++key)
+                    text << (random.nextInt(8) == 0 ? juce::String("x") : juce::String(key)) << "\n";
+
+                directory.getChildFile("map" + juce::String(f) + ".kbm").replaceWithText(text);
+                continue;
+            }
+
+            const int notes = 5 + random.nextInt(68);
+            const bool cents = random.nextBool();
+            text << "! scale" << f << ".scl\n!\nGenerated scale " << f << " with " << notes << " notes\n "
+                 << notes << "\n!\n";
+
+            for (int n = 1; n <= notes; ++n)
+            {
+                if (cents)
+                    text << " " << juce::String(1200.0 * n / notes + random.nextDouble() - 0.5, 6) << "\n";
+                else
+                    text << " " << (notes + n) * 9 << "/" << notes * 9 << "\n";
+            }
+
+            directory.getChildFile("scale" + juce::String(f) + ".scl").replaceWithText(text);
+        }
+    }
+
+    struct Timing
+    {
+        double milliseconds = 0.0;
+        int loaded = 0;
+        juce::int64 allocations = 0;
+    };
+
+    // Best of a few passes, so the page cache is warm for every path alike
+    Timing timePasses(const std::function<int()>& pass)
+    {
+        Timing best;
+        best.milliseconds = std::numeric_limits<double>::max();
+
+        for (int run = 0; run < runs; ++run)
+        {
+            bench::ScopedAllocationCounter counter;
+            const double start = juce::Time::getMillisecondCounterHiRes();
+            const int loaded = pass();
+            const double elapsed = juce::Time::getMillisecondCounterHiRes() - start;
+
+            if (elapsed < best.milliseconds)
+                best = { elapsed, loaded, counter.getCount() };
+        }
+
+        return best;
+    }
+
+    int readWithStreams(const juce::Array<juce::File>& files)
+    {
+        int loaded = 0;
+
+        for (const auto& file : files)
+        {
+            std::ifstream stream(file.getFullPathName().toStdString());
+
+            try
+            {
+                if (file.hasFileExtension("scl"))
+                    loaded += scala::read_scl(stream).get_scale_length() > 1 ? 1 : 0;
+                else
+                    loaded += scala::read_kbm(stream).map_size >= 0 ? 1 : 0;
+            }
+            catch (const std::exception&) {}
+        }
+
+        return loaded;
+    }
+
+    int readMapped(const juce::Array<juce::File>& files)
+    {
+        int loaded = 0;
+
+        for (const auto& file : files)
+        {
+            juce::MemoryMappedFile mapped(file, juce::MemoryMappedFile::readOnly);
+            const auto* text = static_cast<const char*>(mapped.getData());
+
+            if (text == nullptr)
+                continue;
+
+            try
+            {
+                if (file.hasFileExtension("scl"))
+                    loaded += scala::read_scl(text, mapped.getSize()).get_scale_length() > 1 ? 1 : 0;
+                else
+                    loaded += scala::read_kbm(text, mapped.getSize()).map_size >= 0 ? 1 : 0;
+            }
+            catch (const std::exception&) {}
+        }
+
+        return loaded;
+    }
+
+    // Opening the archive and turning every entry into the structures the
+    // tuning table is built from
+    int readCompiled(const juce::File& archiveFile)
+    {
+        juce::String error;
+        const auto archive = TuningArchive::loadFromFile(archiveFile, error);
+
+        if (archive == nullptr)
+            return 0;
+
+        int loaded = 0;
+
+        for (int e = 0; e < archive->getNumEntries(); ++e)
+        {
+            if (archive->getKind(e) == TuningArchive::Kind::scale)
+                loaded += archive->getScale(e).get_scale_length() > 1 ? 1 : 0;
+            else
+                loaded += archive->getKeyboardMapping(e).map_size >= 0 ? 1 : 0;
+        }
+
+        return loaded;
+    }
+
+    void printTiming(const juce::String& label, const Timing& timing, int numFiles, juce::int64 totalBytes)
+    {
+        const double seconds = timing.milliseconds / 1000.0;
+
+        std::cout << "    " << label.paddedRight(' ', 24)
+                  << juce::String(timing.loaded).paddedLeft(' ', 8)
+                  << juce::String(timing.milliseconds, 2).paddedLeft(' ', 10)
+                  << juce::String(1000.0 * timing.milliseconds / juce::jmax(1, numFiles), 2).paddedLeft(' ', 10)
+                  << juce::String(static_cast<double>(totalBytes) / (1024.0 * 1024.0) / juce::jmax(seconds, 1.0e-9), 1).paddedLeft(' ', 10)
+                  << juce::String(static_cast<double>(timing.allocations) / juce::jmax(1, numFiles), 1).paddedLeft(' ', 12)
+                  << std::endl;
+    }
+}
+
+void runScalaParserBenchmark(const juce::File& scalaDirectory)
+{
+    auto directory = scalaDirectory;
+
+    if (! directory.isDirectory())
+    {
+        directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                        .getNonexistentChildFile("ISODRONEScala", {}, false);
+        directory.createDirectory();
+        generateArchive(directory);
+    }
+
+    auto files = directory.findChildFiles(juce::File::findFiles, true, "*.scl;*.kbm");
+    std::sort(files.begin(), files.end());
+
+    juce::int64 totalBytes = 0;
+    TuningArchive::Builder builder;
+
+    for (const auto& file : files)
+    {
+        totalBytes += file.getSize();
+        juce::MemoryMappedFile mapped(file, juce::MemoryMappedFile::readOnly);
+        const auto* text = static_cast<const char*>(mapped.getData());
+
+        if (text == nullptr)
+            continue;
+
+        try
+        {
+            if (file.hasFileExtension("scl"))
+                builder.addScale(file.getFileNameWithoutExtension(), scala::read_scl(text, mapped.getSize()));
+            else
+                builder.addKeyboardMapping(file.getFileNameWithoutExtension(), scala::read_kbm(text, mapped.getSize()));
+        }
+        catch (const std::exception&) {}
+    }
+
+    juce::TemporaryFile compiled(TuningArchive::fileExtension);
+    builder.writeTo(compiled.getFile());
+
+    std::cout << "Scala archive, " << files.size() << " files, "
+              << juce::String(static_cast<double>(totalBytes) / (1024.0 * 1024.0), 2) << " MB"
+              << (scalaDirectory.isDirectory() ? " from " + directory.getFullPathName() : juce::String(" (generated)"))
+              << std::endl;
+    std::cout << "    " << juce::String("path").paddedRight(' ', 24)
+              << juce::String("loaded").paddedLeft(' ', 8)
+              << juce::String("ms").paddedLeft(' ', 10)
+              << juce::String("us/file").paddedLeft(' ', 10)
+              << juce::String("MB/s").paddedLeft(' ', 10)
+              << juce::String("allocs/file").paddedLeft(' ', 12) << std::endl;
+
+    const int numFiles = files.size();
+    printTiming("std::ifstream + parse", timePasses([&] { return readWithStreams(files); }), numFiles, totalBytes);
+    printTiming("mmap + parse", timePasses([&] { return readMapped(files); }), numFiles, totalBytes);
+    printTiming("compiled archive", timePasses([&] { return readCompiled(compiled.getFile()); }), numFiles, totalBytes);
+
+    std::cout << "  Compiled archive: " << juce::String(static_cast<double>(compiled.getFile().getSize()) / (1024.0 * 1024.0), 2)
+              << " MB, one file. MB/s is of the text the archive was built from." << std::endl
+              << std::endl;
+
+    if (! scalaDirectory.isDirectory())
+        directory.deleteRecursively();
+}
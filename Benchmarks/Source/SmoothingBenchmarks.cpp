@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    SmoothingBenchmarks.cpp
+    Created: 17 Oct 2026 3:41:26pm
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "BenchmarkRunner.h"
+#include "../../Source/Data/OscData.h"
+#include "../../Source/Data/VowelFilter.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+
+    // A slow CC-style sweep: every block moves every parameter a little
+    double timeGlottalSweep(double smoothingTime, int blockSize)
+    {
+        GlottalOscillator osc;
+        osc.setSmoothingTime(smoothingTime);
+        osc.prepare({ sampleRate, static_cast<juce::uint32>(blockSize), 1 });
+        osc.setFrequency(110.0f);
+
+        std::vector<float> output(static_cast<size_t>(blockSize));
+        int block = 0;
+
+        const double ns = bench::measureMedianNs([&]
+        {
+            const float sweep = 0.5f + 0.5f * std::sin(static_cast<float>(block++) * 0.05f);
+            osc.setOpenQuotient(0.3f + 0.4f * sweep);
+            osc.setAsymmetryCoeff(0.1f + 1.9f * sweep);
+            osc.setBreathiness(0.2f * sweep);
+            osc.setTenseness(1.0f - 0.5f * sweep);
+
+            for (auto& sample : output)
+                sample = osc.getNextSample();
+        }, 20, 300);
+
+        return ns / blockSize;
+    }
+
+    double timeVowelSweep(double smoothingTime, int blockSize)
+    {
+        VowelFilter filter;
+        filter.setSmoothingTime(smoothingTime);
+        filter.prepareToPlay(sampleRate, blockSize, 2);
+
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::Random random(1234);
+        int block = 0;
+
+        const double ns = bench::measureMedianNs([&]
+        {
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.setSample(channel, i, random.nextFloat() * 0.5f - 0.25f);
+
+            const float sweep = 0.5f + 0.5f * std::sin(static_cast<float>(block++) * 0.05f);
+            filter.setParameters(VowelFilter::getVowelPosition(VowelFilter::A), 0.7f + sweep, 0.8f + 0.4f * sweep, 1.0f + sweep, 1.0f, false);
+            filter.process(buffer);
+        }, 20, 300);
+
+        return ns / blockSize;
+    }
+}
+
+void runSmoothingBenchmark()
+{
+    const int blockSizes[] = { 64, 512, 2048 };
+
+    std::cout << "Parameter smoothing, sweep on every block (ns/sample)" << std::endl;
+    std::cout << "  block   glottal stepped  glottal smoothed   vowel stepped  vowel smoothed" << std::endl;
+
+    for (auto blockSize : blockSizes)
+    {
+        std::cout << "  " << juce::String(blockSize).paddedLeft(' ', 5)
+                  << juce::String(timeGlottalSweep(0.0, blockSize), 2).paddedLeft(' ', 17)
+                  << juce::String(timeGlottalSweep(GlottalOscillator::defaultSmoothingTime, blockSize), 2).paddedLeft(' ', 18)
+                  << juce::String(timeVowelSweep(0.0, blockSize), 2).paddedLeft(' ', 16)
+                  << juce::String(timeVowelSweep(GlottalOscillator::defaultSmoothingTime, blockSize), 2).paddedLeft(' ', 16)
+                  << std::endl;
+    }
+
+    std::cout << std::endl;
+}
@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+    StateBenchmarks.cpp
+    Created: 18 Oct 2026 5:41:09am
+    Author:  zerocase
+
+    Saving and restoring the state of a session's worth of plugin instances,
+    each with a 31-note scale and a keyboard mapping loaded: the binary
+    state against the parameter tree as XML, which is what hosts get from
+    most JUCE plugins. Restore is timed until setStateInformation returns
+    and until every instance is playing its restored tuning.
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "BenchmarkRunner.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr int numInstances = 100;
+    constexpr int runs = 5;
+
+    juce::File writeTestFile(const juce::String& extension, const juce::String& text)
+    {
+        auto file = juce::File::createTempFile(extension);
+        file.replaceWithText(text);
+        return file;
+    }
+
+    // Every instance different, so no two states are alike
+    void randomise(ISODRONEAudioProcessor& processor, juce::Random& random)
+    {
+        for (auto* parameter : processor.getParameters())
+            parameter->setValueNotifyingHost(random.nextFloat());
+
+        processor.midiProcessor.openQuotient = 0.3f + 0.4f * random.nextFloat();
+        processor.midiProcessor.vowelX = random.nextFloat();
+        processor.midiProcessor.vowelY = random.nextFloat();
+    }
+
+    struct Timing
+    {
+        double saveMs = std::numeric_limits<double>::max();
+        double restoreMs = std::numeric_limits<double>::max();
+        double publishedMs = std::numeric_limits<double>::max();
+        size_t bytes = 0;
+    };
+
+    using Processors = std::vector<std::unique_ptr<ISODRONEAudioProcessor>>;
+
+    // Best of a few passes over all instances, restoring each state into a
+    // second set of instances
+    template <typename SaveFunction, typename RestoreFunction>
+    Timing timeStates(Processors& sources, Processors& targets, SaveFunction&& save, RestoreFunction&& restore)
+    {
+        Timing best;
+        std::vector<juce::MemoryBlock> states(sources.size());
+
+        for (int run = 0; run < runs; ++run)
+        {
+            double start = juce::Time::getMillisecondCounterHiRes();
+
+            for (size_t i = 0; i < sources.size(); ++i)
+                save(*sources[i], states[i]);
+
+            best.saveMs = juce::jmin(best.saveMs, juce::Time::getMillisecondCounterHiRes() - start);
+
+            start = juce::Time::getMillisecondCounterHiRes();
+
+            for (size_t i = 0; i < targets.size(); ++i)
+                restore(*targets[i], states[i]);
+
+            best.restoreMs = juce::jmin(best.restoreMs, juce::Time::getMillisecondCounterHiRes() - start);
+
+            for (auto& target : targets)
+                target->midiProcessor.waitForPendingLoads(10000);
+
+            best.publishedMs = juce::jmin(best.publishedMs, juce::Time::getMillisecondCounterHiRes() - start);
+        }
+
+        for (const auto& state : states)
+            best.bytes += state.getSize();
+
+        return best;
+    }
+
+    void printTiming(const juce::String& label, const Timing& timing)
+    {
+        std::cout << "    " << label.paddedRight(' ', 20)
+                  << juce::String(timing.saveMs, 2).paddedLeft(' ', 10)
+                  << juce::String(1000.0 * timing.saveMs / numInstances, 1).paddedLeft(' ', 10)
+                  << juce::String(timing.restoreMs, 2).paddedLeft(' ', 12)
+                  << juce::String(timing.publishedMs, 2).paddedLeft(' ', 12)
+                  << juce::String(static_cast<double>(timing.bytes) / numInstances, 0).paddedLeft(' ', 12)
+                  << std::endl;
+    }
+}
+
+void runStateBenchmark()
+{
+    juce::String scaleText = "! state.scl\n31-EDO\n31\n";
+
+    for (int step = 1; step <= 31; ++step)
+        scaleText << juce::String(1200.0 * step / 31.0, 5) << "\n";
+
+    const auto scale = writeTestFile(".scl", scaleText);
+    const auto mapping = writeTestFile(".kbm", "12\n0\n127\n60\n69\n440.0\n31\n0\n5\n10\n13\n18\n23\n28\nx\n3\n8\n15\n20\n");
+
+    Processors sources, targets;
+    juce::Random random(2026);
+
+    for (int i = 0; i < numInstances; ++i)
+    {
+        sources.push_back(std::make_unique<ISODRONEAudioProcessor>());
+        sources.back()->midiProcessor.loadScalaFile(scale);
+        sources.back()->midiProcessor.loadKbmFile(mapping);
+        randomise(*sources.back(), random);
+        targets.push_back(std::make_unique<ISODRONEAudioProcessor>());
+    }
+
+    std::cout << "Plugin state, " << numInstances << " instances with a scale and mapping loaded" << std::endl;
+    std::cout << "    " << juce::String("format").paddedRight(' ', 20)
+              << juce::String("save ms").paddedLeft(' ', 10)
+              << juce::String("us/inst").paddedLeft(' ', 10)
+              << juce::String("restore ms").paddedLeft(' ', 12)
+              << juce::String("tuned ms").paddedLeft(' ', 12)
+              << juce::String("bytes/inst").paddedLeft(' ', 12) << std::endl;
+
+    printTiming("binary", timeStates(sources, targets,
+        [] (ISODRONEAudioProcessor& processor, juce::MemoryBlock& state) { processor.getStateInformation(state); },
+        [] (ISODRONEAudioProcessor& processor, const juce::MemoryBlock& state)
+        {
+            processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+        }));
+
+    // Parameters only: the XML tree has nowhere to keep the tuning
+    printTiming("XML parameter tree", timeStates(sources, targets,
+        [] (ISODRONEAudioProcessor& processor, juce::MemoryBlock& state)
+        {
+            state.reset();
+
+            if (auto xml = processor.apvts.copyState().createXml())
+                juce::AudioProcessor::copyXmlToBinary(*xml, state);
+        },
+        [] (ISODRONEAudioProcessor& processor, const juce::MemoryBlock& state)
+        {
+            if (auto xml = juce::AudioProcessor::getXmlFromBinary(state.getData(), static_cast<int>(state.getSize())))
+                processor.apvts.replaceState(juce::ValueTree::fromXml(*xml));
+        }));
+
+    // The restored tuning has to match the saved one key for key
+    int mismatches = 0;
+
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+        juce::MemoryBlock state;
+        sources[i]->getStateInformation(state);
+        targets[i]->setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+        targets[i]->midiProcessor.waitForPendingLoads(10000);
+
+        juce::MidiBuffer none;
+        sources[i]->midiProcessor.process(none);
+        targets[i]->midiProcessor.process(none);
+
+        for (int note = 0; note < TuningTable::numNotes; ++note)
+            if (sources[i]->midiProcessor.midiNoteToFrequency(note) != targets[i]->midiProcessor.midiNoteToFrequency(note))
+                ++mismatches;
+    }
+
+    std::cout << "  Restored tunings: " << (mismatches == 0 ? juce::String("identical") : juce::String(mismatches) + " keys differ")
+              << std::endl << std::endl;
+
+    scale.deleteFile();
+    mapping.deleteFile();
+}
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    VoiceBenchmarks.cpp
+    Created: 17 Oct 2026 11:02:40am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "BenchmarkRunner.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    // Spread held notes over several channels so we can hold more than 128
+    juce::MidiMessage droneNoteOn(int voiceIndex)
+    {
+        return juce::MidiMessage::noteOn(1 + voiceIndex / 64, 36 + voiceIndex % 64, 0.8f);
+    }
+}
+
+void runVoiceScalingBenchmark()
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+    const int activeVoiceCounts[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256 };
+
+    std::cout << "Voice scaling (" << sampleRate << " Hz, " << blockSize << " samples, "
+              << IsoSynthesiser::maxVoices << " voice pool)" << std::endl;
+    std::cout << "  voices    us/block    us/block/voice" << std::endl;
+
+    juce::Array<double> voices, costs;
+
+    for (auto numActive : activeVoiceCounts)
+    {
+        ISODRONEAudioProcessor processor;
+        processor.setVoiceCount(IsoSynthesiser::maxVoices);
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> buffer(processor.getTotalNumOutputChannels(), blockSize);
+        juce::MidiBuffer midi;
+
+        for (int v = 0; v < numActive; ++v)
+            midi.addEvent(droneNoteOn(v), 0);
+
+        buffer.clear();
+        processor.processBlock(buffer, midi);
+        midi.clear();
+
+        const double ns = bench::measureMedianNs([&]
+        {
+            buffer.clear();
+            processor.processBlock(buffer, midi);
+        }, 50, 400);
+
+        voices.add(numActive);
+        costs.add(ns / 1000.0);
+
+        std::cout << "  " << juce::String(numActive).paddedLeft(' ', 6)
+                  << juce::String(ns / 1000.0, 2).paddedLeft(' ', 12)
+                  << juce::String(ns / 1000.0 / numActive, 3).paddedLeft(' ', 18) << std::endl;
+
+        processor.releaseResources();
+    }
+
+    const auto fit = bench::fitLine(voices, costs);
+    std::cout << "  linear fit: " << juce::String(fit.slope, 3) << " us/voice + "
+              << juce::String(fit.intercept, 2) << " us, R^2 = " << juce::String(fit.rSquared, 4)
+              << std::endl << std::endl;
+}
@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+    FormantBank.cpp
+    Created: 17 Oct 2026 11:05:52pm
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "FormantBank.h"
+
+void FormantBank::prepare(int numChannels, int newNumFormants)
+{
+    jassert(newNumFormants > 0 && newNumFormants <= maxFormants);
+    
+    numFormants = juce::jlimit(1, maxFormants, newNumFormants);
+    numActiveFormants = numFormants;
+    numVectors = (numFormants + lanes - 1) / lanes;
+    
+    // Unused lanes keep all-zero coefficients, so they output silence
+    coefficients = Coefficients();
+    states.assign(static_cast<size_t>(numChannels), ChannelState());
+}
+
+void FormantBank::reset()
+{
+    std::fill(states.begin(), states.end(), ChannelState());
+}
+
+void FormantBank::setActiveFormants(int numActive) noexcept
+{
+    jassert(numActive > 0 && numActive <= numFormants);
+    numActive = juce::jlimit(1, numFormants, numActive);
+    
+    // Sections that come back still hold whatever state they stopped with,
+    // or state integrated with another formant's coefficients while muted;
+    // start them from rest instead
+    if (numActive > numActiveFormants)
+    {
+        for (auto& state : states)
+        {
+            std::fill(state.ic1 + numActiveFormants, state.ic1 + numActive, 0.0f);
+            std::fill(state.ic2 + numActiveFormants, state.ic2 + numActive, 0.0f);
+        }
+    }
+    
+    numActiveFormants = numActive;
+    numVectors = (numActive + lanes - 1) / lanes;
+    
+    // Lanes past the last active formant share its vector; mute them
+    for (int f = numActive; f < numVectors * lanes; ++f)
+        coefficients.m1[f] = 0.0f;
+}
+
+void FormantBank::setFormant(int formant, float g, float k, float gain) noexcept
+{
+    jassert(formant >= 0 && formant < numFormants);
+    jassert(g > 0.0f && k > 0.0f);
+    
+    // Simper's TPT SVF: a1..a3 solve the zero-delay feedback loop, and the
+    // bandpass output is k * v1 for a unity peak
+    const float a1 = 1.0f / (1.0f + g * (g + k));
+    coefficients.a1[formant] = a1;
+    coefficients.a2[formant] = g * a1;
+    coefficients.a3[formant] = g * g * a1;
+    coefficients.m1[formant] = k * gain;
+}
+
+void FormantBank::process(int channel, float* samples, int numSamples, const float* gains)
+{
+    jassert(channel < static_cast<int>(states.size()));
+    auto& state = states[static_cast<size_t>(channel)];
+    
+    FloatVec a1[maxVectors], a2[maxVectors], a3[maxVectors], m1[maxVectors];
+    FloatVec ic1[maxVectors], ic2[maxVectors];
+    
+    for (int v = 0; v < numVectors; ++v)
+    {
+        a1[v] = FloatVec::fromRawArray(coefficients.a1 + v * lanes);
+        a2[v] = FloatVec::fromRawArray(coefficients.a2 + v * lanes);
+        a3[v] = FloatVec::fromRawArray(coefficients.a3 + v * lanes);
+        m1[v] = FloatVec::fromRawArray(coefficients.m1 + v * lanes);
+        ic1[v] = FloatVec::fromRawArray(state.ic1 + v * lanes);
+        ic2[v] = FloatVec::fromRawArray(state.ic2 + v * lanes);
+    }
+    
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto input = FloatVec::expand(samples[i]);
+        auto sum = FloatVec::expand(0.0f);
+        
+        for (int v = 0; v < numVectors; ++v)
+        {
+            const auto v3 = input - ic2[v];
+            const auto v1 = a1[v] * ic1[v] + a2[v] * v3;
+            const auto v2 = ic2[v] + a2[v] * ic1[v] + a3[v] * v3;
+            ic1[v] = v1 + v1 - ic1[v];
+            ic2[v] = v2 + v2 - ic2[v];
+            sum = sum + m1[v] * v1;
+        }
+        
+        samples[i] = juce::jlimit(-0.95f, 0.95f, sum.sum() * gains[i]);
+    }
+    
+    for (int v = 0; v < numVectors; ++v)
+    {
+        ic1[v].copyToRawArray(state.ic1 + v * lanes);
+        ic2[v].copyToRawArray(state.ic2 + v * lanes);
+    }
+    
+    // Same denormal guard juce::IIRFilter applies after every block
+    for (int f = 0; f < numVectors * lanes; ++f)
+    {
+        JUCE_SNAP_TO_ZERO(state.ic1[f]);
+        JUCE_SNAP_TO_ZERO(state.ic2[f]);
+    }
+}
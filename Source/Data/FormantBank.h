@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    FormantBank.h
+    Created: 17 Oct 2026 11:05:52pm
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Parallel bandpass sections summed into one output. Each section is a
+// topology-preserving (TPT) state variable filter, so its frequency, Q and
+// gain can move every few samples without the state blowing up or clicking,
+// which a direct-form biquad can't promise. Its response is the same as
+// juce::IIRCoefficients::makeBandPass: a constant 0 dB peak.
+//
+// Coefficients and state are stored as structure-of-arrays, one SIMD lane
+// per formant, so all formants of a channel advance together: 4 per vector
+// on SSE/NEON, 8 on AVX. Up to maxFormants sections cost about the same as
+// three.
+class FormantBank
+{
+public:
+    using FloatVec = juce::dsp::SIMDRegister<float>;
+    
+    static constexpr int lanes = static_cast<int>(FloatVec::SIMDNumElements);
+    static constexpr int maxFormants = 8;
+    static constexpr int maxVectors = (maxFormants + lanes - 1) / lanes;
+    
+    // Allocates the per-channel state; never call from the audio thread
+    void prepare(int numChannels, int numFormants);
+    void reset();
+    
+    int getNumFormants() const { return numFormants; }
+    
+    // Runs only the first numActive of the prepared formants, so a set with
+    // fewer formants doesn't pay for empty vectors. Sections that become
+    // active again start from rest. Audio thread safe.
+    void setActiveFormants(int numActive) noexcept;
+    
+    // g = tan (pi * frequency / sampleRate), k = 1 / Q, gain scales the
+    // section's output. Cheap enough to call for every formant every sub-block.
+    void setFormant(int formant, float g, float k, float gain) noexcept;
+    
+    // Filters one channel in place: every sample goes through all formants,
+    // the outputs are summed, multiplied by gains[i] and clipped to +-0.95
+    void process(int channel, float* samples, int numSamples, const float* gains);
+    
+private:
+    struct alignas(64) Coefficients
+    {
+        float a1[maxVectors * lanes] = {}, a2[maxVectors * lanes] = {}, a3[maxVectors * lanes] = {};
+        float m1[maxVectors * lanes] = {};
+    };
+    
+    // The two integrator states of every section
+    struct alignas(64) ChannelState
+    {
+        float ic1[maxVectors * lanes] = {}, ic2[maxVectors * lanes] = {};
+    };
+    
+    Coefficients coefficients;
+    std::vector<ChannelState> states;
+    int numFormants = 0;
+    int numActiveFormants = 0;
+    int numVectors = 0;
+};
@@ -0,0 +1,32 @@
+/*
+  ==============================================================================
+
+    FormantCoefficientTable.cpp
+    Created: 17 Oct 2026 11:42:18pm
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "FormantCoefficientTable.h"
+
+FormantCoefficientTable::FormantCoefficientTable()
+{
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const double frequency = std::exp2(minLog2Frequency + i / static_cast<double>(pointsPerOctave));
+        gains[i] = static_cast<float>(std::tan(juce::MathConstants<double>::pi * frequency));
+    }
+}
+
+float FormantCoefficientTable::lookup(float log2NormalisedFrequency) const noexcept
+{
+    const float x = juce::jlimit(0.0f, static_cast<float>(numPoints - 1),
+                                 (log2NormalisedFrequency - minLog2Frequency) * pointsPerOctave);
+    
+    // The last point interpolates with weight 0 against itself
+    const int i = juce::jmin(static_cast<int>(x), numPoints - 2);
+    const float fraction = x - static_cast<float>(i);
+    
+    return gains[i] + fraction * (gains[i + 1] - gains[i]);
+}
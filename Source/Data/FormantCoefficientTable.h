@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+    FormantCoefficientTable.h
+    Created: 17 Oct 2026 11:42:18pm
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Precomputed state variable filter integrator gains, g = tan (pi * f / fs),
+// over log2 normalised frequency (frequency / sample rate) and linearly
+// interpolated on lookup. Retuning a formant then costs a few multiply-adds
+// instead of a tan(), which matters during glides, vowel sweeps and pitch
+// bends where every voice retunes every sub-block.
+//
+// Like the glottal wavetables, the grid is normalised so one table serves
+// every sample rate, and every vowel and formant shares it. Q needs no table:
+// the filter takes 1 / Q directly.
+class FormantCoefficientTable
+{
+public:
+    // 24 points per octave from 2^-16 up to 2^-1.25 (0.42 fs). The bottom
+    // has to reach the 50 Hz formant floor at the highest rate the bank runs
+    // at: 8x oversampling of 96k puts 2^-16 at 11.7 Hz.
+    static constexpr int pointsPerOctave = 24;
+    static constexpr float minLog2Frequency = -16.0f;
+    static constexpr int numPoints = 355;
+    
+    FormantCoefficientTable();
+    
+    // Arguments outside the grid are clamped to its edges. Audio thread safe.
+    float lookup(float log2NormalisedFrequency) const noexcept;
+    
+private:
+    float gains[numPoints];
+};
@@ -0,0 +1,357 @@
+/*
+  ==============================================================================
+
+    FormantLibrary.cpp
+    Created: 18 Oct 2026 12:26:40am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "FormantLibrary.h"
+
+namespace
+{
+    // Binary layout: Header, numSets SetRecords, then numVowels FormantVowels.
+    // Every record is a multiple of 4 bytes, so mapped data stays aligned.
+    struct Header
+    {
+        char magic[4];
+        juce::uint32 version;
+        juce::uint32 numSets;
+        juce::uint32 numVowels;
+    };
+
+    struct SetRecord
+    {
+        char name[24];
+        juce::uint32 firstVowel;
+        juce::uint32 numVowels;
+        juce::uint32 numFormants;
+    };
+
+    constexpr char magic[4] = { 'I', 'S', 'O', 'F' };
+    constexpr juce::uint32 formatVersion = 1;
+
+    static_assert(sizeof(Header) == 16 && sizeof(SetRecord) == 36 && sizeof(FormantVowel) == 76,
+                  "FormantLibrary records must match the file format");
+
+    // Vowel space positions as in VowelFilter::getVowelPosition
+    const char* const builtInLibrary = R"(
+# The original ISODRONE vowels
+set Classic
+vowel a 0.5 1.0   730  80  3.52   1090  90  0.00   2440 120  -6.02
+vowel e 0.0 0.5   530  80  3.52   1840  90  1.58   2480 120  -4.44
+vowel i 0.0 0.0   270  40  1.58   2290  90  3.52   3010 120  -1.94
+vowel o 1.0 0.5   570  80  3.52    840  80 -1.94   2410 120  -6.02
+vowel u 1.0 0.0   440  80  1.58   1020  80 -4.44   2240 120  -7.96
+
+# Singing voice formants after the Csound manual's formant table
+set Soprano
+vowel a 0.5 1.0   800  80 0   1150  90  -6   2900 120 -32   3900 130 -20   4950 140 -50
+vowel e 0.0 0.5   350  60 0   2000 100 -20   2800 120 -15   3600 150 -40   4950 200 -56
+vowel i 0.0 0.0   270  60 0   2140  90 -12   2950 100 -26   3900 120 -26   4950 120 -44
+vowel o 1.0 0.5   450  70 0    800  80 -11   2830 100 -22   3800 130 -22   4950 135 -50
+vowel u 1.0 0.0   325  50 0    700  60 -16   2700 170 -35   3800 180 -40   4950 200 -60
+
+set Alto
+vowel a 0.5 1.0   800  80 0   1150  90  -4   2800 120 -20   3500 130 -36   4950 140 -60
+vowel e 0.0 0.5   400  60 0   1600  80 -24   2700 120 -30   3300 150 -35   4950 200 -60
+vowel i 0.0 0.0   350  50 0   1700 100 -20   2700 120 -30   3700 150 -36   4950 200 -60
+vowel o 1.0 0.5   450  70 0    800  80  -9   2830 100 -16   3500 130 -28   4950 135 -55
+vowel u 1.0 0.0   325  50 0    700  60 -12   2530 170 -30   3500 180 -40   4950 200 -64
+
+set Tenor
+vowel a 0.5 1.0   650  80 0   1080  90  -6   2650 120  -7   2900 130  -8   3250 140 -22
+vowel e 0.0 0.5   400  70 0   1700  80 -14   2600 100 -12   3200 120 -14   3580 120 -20
+vowel i 0.0 0.0   290  40 0   1870  90 -15   2800 100 -18   3250 120 -20   3540 120 -30
+vowel o 1.0 0.5   400  40 0    800  80 -10   2600 100 -12   2800 120 -12   3000 120 -26
+vowel u 1.0 0.0   350  40 0    600  60 -20   2700 100 -17   2900 120 -14   3300 120 -26
+
+set Bass
+vowel a 0.5 1.0   600  60 0   1040  70  -7   2250 110  -9   2450 120  -9   2750 130 -20
+vowel e 0.0 0.5   400  40 0   1620  80 -12   2400 100  -9   2800 120 -12   3100 120 -18
+vowel i 0.0 0.0   250  60 0   1750  90 -30   2600 100 -16   3050 120 -22   3340 120 -28
+vowel o 1.0 0.5   400  40 0    750  80 -11   2400 100 -21   2600 120 -20   2900 120 -40
+vowel u 1.0 0.0   350  40 0    600  80 -20   2400 100 -32   2675 120 -28   2950 120 -36
+
+# Child speech: F1-F3 after Peterson & Barney, upper formants estimated
+set Child
+vowel a 0.5 1.0  1030 100 0   1370 110  -6   3170 150 -28   4300 160 -30   5200 170 -45
+vowel e 0.0 0.5   690  75 0   2610 120 -16   3570 150 -20   4500 180 -38   5300 240 -50
+vowel i 0.0 0.0   370  70 0   3200 110 -14   3730 120 -22   4600 150 -30   5400 150 -44
+vowel o 1.0 0.5   680  85 0   1060 100  -9   3180 120 -24   4300 160 -30   5200 160 -48
+vowel u 1.0 0.0   430  60 0   1170  70 -14   3260 200 -34   4300 220 -40   5200 240 -58
+)";
+
+    void copyName(char* destination, size_t size, const juce::String& name)
+    {
+        std::fill(destination, destination + size, 0);
+        name.copyToUTF8(destination, size);   // Truncates and terminates
+    }
+}
+
+//==============================================================================
+FormantLibrary::FormantLibrary()
+{
+    juce::String error;
+    auto builtIn = parseText(builtInLibrary, error);
+    jassert(builtIn != nullptr);   // The built-in text must always parse
+
+    owned = std::move(builtIn->owned);
+    data = owned.getData();
+    dataSize = owned.getSize();
+    index(error);
+}
+
+FormantLibrary::FormantLibrary(std::unique_ptr<juce::MemoryMappedFile> mappedFile, juce::MemoryBlock ownedData)
+    : mapped(std::move(mappedFile))
+    , owned(std::move(ownedData))
+{
+    if (mapped != nullptr)
+    {
+        data = mapped->getData();
+        dataSize = mapped->getSize();
+    }
+    else
+    {
+        data = owned.getData();
+        dataSize = owned.getSize();
+    }
+}
+
+std::unique_ptr<FormantLibrary> FormantLibrary::loadFromFile(const juce::File& file, juce::String& error)
+{
+    if (juce::ByteOrder::isBigEndian())
+    {
+        error = "formant libraries are little-endian only";
+        return nullptr;
+    }
+
+    auto mappedFile = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+
+    if (mappedFile->getData() == nullptr)
+    {
+        error = "could not open " + file.getFullPathName();
+        return nullptr;
+    }
+
+    // Not ours: drop the mapping and read it as text
+    if (mappedFile->getSize() < sizeof(Header) || std::memcmp(mappedFile->getData(), magic, sizeof(magic)) != 0)
+        return parseText(file.loadFileAsString(), error);
+
+    std::unique_ptr<FormantLibrary> library(new FormantLibrary(std::move(mappedFile), {}));
+
+    if (! library->index(error))
+        return nullptr;
+
+    return library;
+}
+
+std::unique_ptr<FormantLibrary> FormantLibrary::parseText(const juce::String& text, juce::String& error)
+{
+    std::vector<SetRecord> setRecords;
+    std::vector<FormantVowel> vowels;
+
+    auto lines = juce::StringArray::fromLines(text);
+
+    for (int lineNumber = 0; lineNumber < lines.size(); ++lineNumber)
+    {
+        const auto line = lines[lineNumber].upToFirstOccurrenceOf("#", false, false).trim();
+
+        if (line.isEmpty())
+            continue;
+
+        auto tokens = juce::StringArray::fromTokens(line, " \t", {});
+        tokens.removeEmptyStrings();
+
+        const auto fail = [&] (const juce::String& message)
+        {
+            error = "line " + juce::String(lineNumber + 1) + ": " + message;
+            return nullptr;
+        };
+
+        if (tokens[0] == "set")
+        {
+            if (tokens.size() != 2)
+                return fail("expected 'set <name>'");
+
+            SetRecord record {};
+            copyName(record.name, sizeof(record.name), tokens[1]);
+            record.firstVowel = static_cast<juce::uint32>(vowels.size());
+            setRecords.push_back(record);
+        }
+        else if (tokens[0] == "vowel")
+        {
+            if (setRecords.empty())
+                return fail("vowel before the first set");
+
+            const int numFormants = (tokens.size() - 4) / 3;
+
+            if (tokens.size() < 7 || (tokens.size() - 4) % 3 != 0 || numFormants > FormantVowel::maxFormants)
+                return fail("expected 'vowel <name> <x> <y>' and 1 to " + juce::String(FormantVowel::maxFormants)
+                            + " frequency, bandwidth, dB triples");
+
+            auto& set = setRecords.back();
+
+            if (static_cast<int>(set.numVowels) == FormantSet::maxVowels)
+                return fail("more than " + juce::String(FormantSet::maxVowels) + " vowels in a set");
+
+            if (set.numVowels > 0 && static_cast<int>(set.numFormants) != numFormants)
+                return fail("every vowel of a set needs the same number of formants");
+
+            FormantVowel vowel {};
+            copyName(vowel.name, sizeof(vowel.name), tokens[1]);
+            vowel.x = juce::jlimit(0.0f, 1.0f, tokens[2].getFloatValue());
+            vowel.y = juce::jlimit(0.0f, 1.0f, tokens[3].getFloatValue());
+
+            for (int f = 0; f < numFormants; ++f)
+            {
+                const float frequency = tokens[4 + f * 3].getFloatValue();
+                const float bandwidth = tokens[5 + f * 3].getFloatValue();
+
+                if (frequency <= 0.0f || bandwidth <= 0.0f)
+                    return fail("frequencies and bandwidths must be positive");
+
+                vowel.log2Frequency[f] = std::log2(frequency);
+                vowel.log2Bandwidth[f] = std::log2(bandwidth);
+                vowel.gain[f] = juce::Decibels::decibelsToGain(tokens[6 + f * 3].getFloatValue(), -120.0f);
+            }
+
+            set.numFormants = static_cast<juce::uint32>(numFormants);
+            ++set.numVowels;
+            vowels.push_back(vowel);
+        }
+        else
+        {
+            return fail("unknown statement '" + tokens[0] + "'");
+        }
+    }
+
+    if (setRecords.empty())
+    {
+        error = "no formant sets";
+        return nullptr;
+    }
+
+    Header header;
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = formatVersion;
+    header.numSets = static_cast<juce::uint32>(setRecords.size());
+    header.numVowels = static_cast<juce::uint32>(vowels.size());
+
+    juce::MemoryBlock block;
+    block.append(&header, sizeof(header));
+    block.append(setRecords.data(), setRecords.size() * sizeof(SetRecord));
+    block.append(vowels.data(), vowels.size() * sizeof(FormantVowel));
+
+    std::unique_ptr<FormantLibrary> library(new FormantLibrary(nullptr, std::move(block)));
+
+    if (! library->index(error))
+        return nullptr;
+
+    return library;
+}
+
+bool FormantLibrary::writeBinary(const juce::File& file) const
+{
+    return file.replaceWithData(data, dataSize);
+}
+
+bool FormantLibrary::index(juce::String& error)
+{
+    sets.clear();
+
+    if (dataSize < sizeof(Header))
+    {
+        error = "file too short";
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+
+    if (header.version != formatVersion)
+    {
+        error = "unsupported formant library version " + juce::String(header.version);
+        return false;
+    }
+
+    const size_t vowelsOffset = sizeof(Header) + header.numSets * sizeof(SetRecord);
+
+    if (header.numSets == 0 || vowelsOffset + header.numVowels * sizeof(FormantVowel) > dataSize)
+    {
+        error = "truncated formant library";
+        return false;
+    }
+
+    const auto* bytes = static_cast<const char*>(data);
+    const auto* records = reinterpret_cast<const SetRecord*>(bytes + sizeof(Header));
+    const auto* vowels = reinterpret_cast<const FormantVowel*>(bytes + vowelsOffset);
+
+    // Vowels feed the filters straight from the file, so nothing may be NaN or infinite
+    for (juce::uint32 v = 0; v < header.numVowels; ++v)
+    {
+        const auto& vowel = vowels[v];
+        bool finite = std::isfinite(vowel.x) && std::isfinite(vowel.y);
+
+        for (int f = 0; f < FormantVowel::maxFormants; ++f)
+            finite = finite && std::isfinite(vowel.log2Frequency[f]) && std::isfinite(vowel.log2Bandwidth[f])
+                            && std::isfinite(vowel.gain[f]);
+
+        if (! finite)
+        {
+            error = "corrupt formant vowel " + juce::String(v);
+            return false;
+        }
+    }
+
+    for (juce::uint32 s = 0; s < header.numSets; ++s)
+    {
+        const auto& record = records[s];
+
+        if (record.numVowels == 0 || record.numVowels > FormantSet::maxVowels
+            || record.firstVowel > header.numVowels || record.numVowels > header.numVowels - record.firstVowel
+            || record.numFormants == 0 || record.numFormants > FormantVowel::maxFormants)
+        {
+            error = "corrupt formant set " + juce::String(s);
+            sets.clear();
+            return false;
+        }
+
+        FormantSet set;
+        const auto nameLength = std::find(record.name, record.name + sizeof(record.name), '\0') - record.name;
+        set.name = juce::String::fromUTF8(record.name, static_cast<int>(nameLength));
+        set.vowels = vowels + record.firstVowel;
+        set.numVowels = static_cast<int>(record.numVowels);
+        set.numFormants = static_cast<int>(record.numFormants);
+        sets.push_back(set);
+    }
+
+    return true;
+}
+
+const FormantSet& FormantLibrary::getSet(int setIndex) const noexcept
+{
+    return sets[static_cast<size_t>(juce::jlimit(0, getNumSets() - 1, setIndex))];
+}
+
+//==============================================================================
+FormantLibraryCache::FormantLibraryCache()
+{
+    libraries.push_back(std::make_unique<FormantLibrary>());
+    current.store(libraries.back().get(), std::memory_order_release);
+}
+
+bool FormantLibraryCache::loadLibrary(const juce::File& file, juce::String& error)
+{
+    auto library = FormantLibrary::loadFromFile(file, error);
+
+    if (library == nullptr)
+        return false;
+
+    const juce::ScopedLock lock(loadLock);
+    libraries.push_back(std::move(library));
+    current.store(libraries.back().get(), std::memory_order_release);
+    return true;
+}
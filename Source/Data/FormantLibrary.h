@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    FormantLibrary.h
+    Created: 18 Oct 2026 12:26:40am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// One vowel of a formant set, exactly as it is laid out in a binary library
+// file: frequencies and bandwidths are stored as log2 Hz, ready for the vowel
+// morph, gains as linear amplitude. All fields are 4 byte little-endian.
+struct FormantVowel
+{
+    static constexpr int maxFormants = 5;
+
+    char name[8];                           // Null padded
+    float x, y;                             // Position in the vowel space, see VowelFilter
+    float log2Frequency[maxFormants];
+    float log2Bandwidth[maxFormants];
+    float gain[maxFormants];
+};
+
+// A voice type: a vowel inventory with up to FormantVowel::maxFormants
+// formants each. A view into its library's memory.
+struct FormantSet
+{
+    static constexpr int maxVowels = 32;
+    
+    juce::String name;
+    const FormantVowel* vowels = nullptr;
+    int numVowels = 0;
+    int numFormants = 0;
+};
+
+// An immutable collection of formant sets. The binary form is memory mapped
+// and read in place, so a large library costs address space rather than
+// heap, and the pages are shared by every plugin instance in the process.
+//
+// Text form, one statement per line, '#' starts a comment:
+//
+//     set <name>
+//     vowel <name> <x> <y> <frequency Hz> <bandwidth Hz> <amplitude dB> ...
+//
+// with one frequency/bandwidth/amplitude triple per formant; every vowel of a
+// set needs the same number of formants.
+class FormantLibrary
+{
+public:
+    // Built-in library: Classic (the original three formant vowels) and five
+    // formant soprano, alto, tenor, bass and child sets
+    FormantLibrary();
+
+    // Binary files are memory mapped, anything else is parsed as text.
+    // Returns nullptr and fills in error on failure. Message thread only.
+    static std::unique_ptr<FormantLibrary> loadFromFile(const juce::File& file, juce::String& error);
+    static std::unique_ptr<FormantLibrary> parseText(const juce::String& text, juce::String& error);
+
+    // Writes the compact binary form, for loadFromFile to map
+    bool writeBinary(const juce::File& file) const;
+
+    int getNumSets() const noexcept { return static_cast<int>(sets.size()); }
+
+    // Out of range indices clamp, so a stale selection still gets a set
+    const FormantSet& getSet(int index) const noexcept;
+
+private:
+    FormantLibrary(std::unique_ptr<juce::MemoryMappedFile> mappedFile, juce::MemoryBlock ownedData);
+    bool index(juce::String& error);
+
+    std::unique_ptr<juce::MemoryMappedFile> mapped;
+    juce::MemoryBlock owned;
+    const void* data = nullptr;
+    size_t dataSize = 0;
+    std::vector<FormantSet> sets;
+};
+
+// The process-wide current library, shared by every VowelFilter of every
+// plugin instance through a SharedResourcePointer. Loading publishes the new
+// library with one atomic store; voices pick it up on their next block.
+class FormantLibraryCache
+{
+public:
+    FormantLibraryCache();
+
+    // Lock-free, audio thread safe. Never nullptr.
+    const FormantLibrary* getLibrary() const noexcept { return current.load(std::memory_order_acquire); }
+
+    // Message thread only. Returns false and keeps the current library on failure.
+    bool loadLibrary(const juce::File& file, juce::String& error);
+
+private:
+    // Replaced libraries are only freed with the cache: a voice may still be
+    // reading one, and loads are rare enough that keeping them is cheap
+    std::vector<std::unique_ptr<FormantLibrary>> libraries;
+    std::atomic<const FormantLibrary*> current { nullptr };
+    juce::CriticalSection loadLock;
+};
@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    GlottalWavetable.cpp
+    Created: 17 Oct 2026 9:48:31pm
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "GlottalWavetable.h"
+
+namespace
+{
+    // The analytic cycle is sampled this many times finer than the tables, so
+    // its own aliasing lands far above the harmonics we keep
+    constexpr int analysisOrder = 13;
+    constexpr int analysisSize = 1 << analysisOrder;
+    constexpr int decimation = analysisSize / GlottalWavetableBank::tableSize;
+    
+    float gridValue(int index, int count, float minValue, float maxValue)
+    {
+        return minValue + (maxValue - minValue) * static_cast<float>(index) / static_cast<float>(count - 1);
+    }
+}
+
+GlottalWavetableBank::GlottalWavetableBank(const std::function<bool()>& shouldAbort)
+    : tables(static_cast<size_t>(numMipLevels * numOpenQuotients * numAsymmetries * (tableSize + 1)), true)
+{
+    juce::dsp::FFT fft(analysisOrder);
+    std::vector<float> spectrum(static_cast<size_t>(analysisSize) * 2);
+    std::vector<float> work(static_cast<size_t>(analysisSize) * 2);
+    
+    for (int oq = 0; oq < numOpenQuotients; ++oq)
+    {
+        for (int asym = 0; asym < numAsymmetries; ++asym)
+        {
+            if (shouldAbort && shouldAbort())
+                return;
+            
+            const float openQuotient = gridValue(oq, numOpenQuotients, minOpenQuotient, maxOpenQuotient);
+            const float asymmetry = gridValue(asym, numAsymmetries, minAsymmetry, maxAsymmetry);
+            
+            std::fill(spectrum.begin(), spectrum.end(), 0.0f);
+            
+            for (int i = 0; i < analysisSize; ++i)
+                spectrum[static_cast<size_t>(i)] = analyticPulse(static_cast<float>(i) / analysisSize, openQuotient, asymmetry);
+            
+            fft.performRealOnlyForwardTransform(spectrum.data());
+            
+            for (int mip = 0; mip < numMipLevels; ++mip)
+            {
+                const int harmonics = maxHarmonics >> mip;
+                std::fill(work.begin(), work.end(), 0.0f);
+                
+                // DC and the kept harmonics, mirrored into the negative frequencies
+                for (int h = 0; h <= harmonics; ++h)
+                {
+                    const auto re = spectrum[static_cast<size_t>(2 * h)];
+                    const auto im = spectrum[static_cast<size_t>(2 * h + 1)];
+                    work[static_cast<size_t>(2 * h)] = re;
+                    work[static_cast<size_t>(2 * h + 1)] = im;
+                    
+                    if (h > 0)
+                    {
+                        work[static_cast<size_t>(2 * (analysisSize - h))] = re;
+                        work[static_cast<size_t>(2 * (analysisSize - h) + 1)] = -im;
+                    }
+                }
+                
+                fft.performRealOnlyInverseTransform(work.data());
+                
+                auto* table = tables.getData() + tableOffset(mip, oq, asym);
+                
+                for (int i = 0; i < tableSize; ++i)
+                    table[i] = work[static_cast<size_t>(i * decimation)];
+                
+                table[tableSize] = table[0];
+            }
+        }
+    }
+    
+    complete = true;
+}
+
+int GlottalWavetableBank::getMipLevel(float phaseIncrement) noexcept
+{
+    // Level m is safe while phaseIncrement * (maxHarmonics >> m) < 0.5
+    for (int mip = 0; mip < numMipLevels - 1; ++mip)
+        if (phaseIncrement * static_cast<float>(maxHarmonics >> mip) < 0.5f)
+            return mip;
+    
+    return numMipLevels - 1;
+}
+
+float GlottalWavetableBank::analyticPulse(float phase, float openQuotient, float asymmetry) noexcept
+{
+    const float te = openQuotient * 0.7f;
+    const float tp = te * 0.4f;
+    
+    if (phase < te)
+        return std::sin(juce::MathConstants<float>::pi * phase / tp);
+    
+    if (phase < openQuotient)
+    {
+        const float t = (phase - tp) / (te - tp);
+        return std::exp(-asymmetry * t) * std::cos(juce::MathConstants<float>::pi * t);
+    }
+    
+    return 0.0f;
+}
+
+//==============================================================================
+GlottalWavetableCache::GlottalWavetableCache()
+    : juce::Thread("ISODRONE wavetable builder")
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+GlottalWavetableCache::~GlottalWavetableCache()
+{
+    stopThread(5000);
+}
+
+bool GlottalWavetableCache::waitUntilBuilt(int timeoutMs) const
+{
+    return built.wait(timeoutMs);
+}
+
+void GlottalWavetableCache::run()
+{
+    storage = std::make_unique<GlottalWavetableBank>([this] { return threadShouldExit(); });
+    
+    if (storage->isComplete())
+        bank.store(storage.get(), std::memory_order_release);
+    
+    built.signal();
+}
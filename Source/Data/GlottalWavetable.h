@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    GlottalWavetable.h
+    Created: 17 Oct 2026 9:48:31pm
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Band-limited single-cycle tables of the LF glottal pulse over a grid of
+// open quotient x asymmetry, with one mip level per octave of fundamental.
+//
+// Mip levels are chosen by phase increment (frequency / sample rate) rather
+// than by frequency in Hz, so one bank serves every sample rate. Level m holds
+// at most maxHarmonics >> m harmonics and is used for increments up to
+// 0.5 / (maxHarmonics >> m), which keeps every partial below Nyquist.
+class GlottalWavetableBank
+{
+public:
+    static constexpr int tableSize = 2048;
+    static constexpr int maxHarmonics = tableSize / 2 - 1;
+    static constexpr int numMipLevels = 10;
+    
+    static constexpr int numOpenQuotients = 9;   // 0.3 to 0.7
+    static constexpr int numAsymmetries = 8;     // 0.1 to 2.0
+    static constexpr float minOpenQuotient = 0.3f, maxOpenQuotient = 0.7f;
+    static constexpr float minAsymmetry = 0.1f, maxAsymmetry = 2.0f;
+    
+    // Builds every table; takes a while, so never call this on the audio thread.
+    // Returns early (leaving the bank incomplete) if shouldAbort() returns true.
+    explicit GlottalWavetableBank(const std::function<bool()>& shouldAbort = {});
+    
+    bool isComplete() const noexcept { return complete; }
+    
+    // tableSize + 1 samples; the last repeats the first for interpolation
+    const float* getTable(int mipLevel, int openQuotientIndex, int asymmetryIndex) const noexcept
+    {
+        return tables.getData() + tableOffset(mipLevel, openQuotientIndex, asymmetryIndex);
+    }
+    
+    static int getMipLevel(float phaseIncrement) noexcept;
+    
+    // The analytic pulse the tables are built from (GlottalOscillator::generateLFPulse)
+    static float analyticPulse(float phase, float openQuotient, float asymmetry) noexcept;
+    
+private:
+    static size_t tableOffset(int mipLevel, int openQuotientIndex, int asymmetryIndex) noexcept
+    {
+        return static_cast<size_t>(((mipLevel * numOpenQuotients + openQuotientIndex) * numAsymmetries
+                                    + asymmetryIndex) * (tableSize + 1));
+    }
+    
+    juce::HeapBlock<float> tables;
+    bool complete = false;
+};
+
+// The process-wide bank. Every GlottalOscillator holds one of these through a
+// SharedResourcePointer, so the bank is built once, in the background, when
+// the first oscillator appears and freed when the last one goes away.
+class GlottalWavetableCache : private juce::Thread
+{
+public:
+    GlottalWavetableCache();
+    ~GlottalWavetableCache() override;
+    
+    // nullptr until the background build has finished. Lock-free, audio thread safe.
+    const GlottalWavetableBank* getBank() const noexcept { return bank.load(std::memory_order_acquire); }
+    
+    // For offline tools and benchmarks only
+    bool waitUntilBuilt(int timeoutMs) const;
+    
+private:
+    void run() override;
+    
+    std::unique_ptr<GlottalWavetableBank> storage;
+    std::atomic<const GlottalWavetableBank*> bank { nullptr };
+    mutable juce::WaitableEvent built { true };
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GlottalWavetableCache)
+};
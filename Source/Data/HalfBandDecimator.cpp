@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+    HalfBandDecimator.cpp
+    Created: 18 Oct 2026 7:02:18am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "HalfBandDecimator.h"
+
+namespace
+{
+    // Nonzero side taps per stage, from the one nearest the output rate.
+    // Kaiser windowed with beta 8. The passbands end at 0.21, 0.105 and
+    // 0.0525 of each stage's input rate, so only the last stage needs a steep
+    // edge: 17 pairs (67 taps) there and 6 (23 taps) for each one before,
+    // all at least 80 dB down.
+    constexpr int sideTaps[] = { 17, 6, 6 };
+    constexpr double kaiserBeta = 8.0;
+
+    // Zeroth order modified Bessel function of the first kind, for the window
+    double besselI0(double x)
+    {
+        double sum = 1.0, term = 1.0;
+
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+        }
+
+        return sum;
+    }
+}
+
+//==============================================================================
+void HalfBandDecimator::Stage::design(int numSideTaps)
+{
+    // Windowed sinc at a quarter of the input rate: the taps at even
+    // distances from the centre are exactly zero, so only odd ones are kept
+    centre = 2 * numSideTaps - 1;
+    coefficients.resize(static_cast<size_t>(numSideTaps));
+
+    double sum = 0.0;
+
+    for (int k = 0; k < numSideTaps; ++k)
+    {
+        const int n = 2 * k + 1;
+        const double ratio = static_cast<double>(n) / (centre + 1);
+        const double window = besselI0(kaiserBeta * std::sqrt(1.0 - ratio * ratio)) / besselI0(kaiserBeta);
+        const double sinc = std::sin(juce::MathConstants<double>::halfPi * n) / (juce::MathConstants<double>::halfPi * n);
+
+        coefficients[static_cast<size_t>(k)] = static_cast<float>(0.5 * sinc * window);
+        sum += 2.0 * 0.5 * sinc * window;
+    }
+
+    // Unity gain at DC: the side taps have to add up to the centre's 0.5
+    for (auto& coefficient : coefficients)
+        coefficient = static_cast<float>(coefficient * 0.5 / sum);
+}
+
+void HalfBandDecimator::Stage::process(int channel, const float* input, float* output, int numOutputSamples) noexcept
+{
+    auto& buffer = work[static_cast<size_t>(channel)];
+    const int history = 2 * centre;
+    const int numInputSamples = 2 * numOutputSamples;
+
+    std::copy(input, input + numInputSamples, buffer.begin() + history);
+
+    const float* data = buffer.data();
+    const float* taps = coefficients.data();
+    const int numTaps = static_cast<int>(coefficients.size());
+
+    for (int i = 0; i < numOutputSamples; ++i)
+    {
+        const float* middle = data + 2 * i + centre;
+        float sum = 0.5f * middle[0];
+
+        for (int k = 0; k < numTaps; ++k)
+            sum += taps[k] * (middle[-(2 * k + 1)] + middle[2 * k + 1]);
+
+        output[i] = sum;
+    }
+
+    // Keep the tail for the next block
+    std::copy(buffer.begin() + numInputSamples, buffer.begin() + numInputSamples + history, buffer.begin());
+}
+
+//==============================================================================
+void HalfBandDecimator::prepare(int factorToUse, int numChannels, int maxOutputSamples)
+{
+    factor = juce::jlimit(1, maxFactor, juce::nextPowerOfTwo(juce::jmax(1, factorToUse)));
+    stages.clear();
+    latency = 0.0;
+
+    // From the highest rate down, so the last stage is the long one
+    for (int rate = factor; rate > 1; rate /= 2)
+    {
+        const int stageIndex = static_cast<int>(std::log2(rate)) - 1;
+        Stage stage;
+        stage.design(sideTaps[stageIndex]);
+        stage.work.assign(static_cast<size_t>(numChannels),
+                          std::vector<float>(static_cast<size_t>(2 * stage.centre + maxOutputSamples * rate), 0.0f));
+
+        // centre input samples of delay, at this stage's input rate
+        latency += static_cast<double>(stage.centre) / rate;
+        stages.push_back(std::move(stage));
+    }
+
+    for (auto& buffer : intermediate)
+        buffer.setSize(numChannels, maxOutputSamples * factor / 2);
+}
+
+void HalfBandDecimator::reset()
+{
+    for (auto& stage : stages)
+        for (auto& buffer : stage.work)
+            std::fill(buffer.begin(), buffer.end(), 0.0f);
+}
+
+void HalfBandDecimator::process(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output,
+                                int outputStart, int numOutputSamples) noexcept
+{
+    const int numChannels = juce::jmin(input.getNumChannels(), output.getNumChannels(),
+                                       intermediate[0].getNumChannels());
+
+    if (stages.empty())
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            output.addFrom(channel, outputStart, input, channel, 0, numOutputSamples);
+
+        return;
+    }
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        // Ping-pong between the intermediate buffers; the last stage writes
+        // to the first, which is then added to the output
+        const float* source = input.getReadPointer(channel);
+        int rate = factor;
+        int target = static_cast<int>(stages.size()) % 2 == 0 ? 1 : 0;
+
+        for (auto& stage : stages)
+        {
+            rate /= 2;
+            auto* destination = intermediate[target].getWritePointer(channel);
+            stage.process(channel, source, destination, numOutputSamples * rate);
+            source = destination;
+            target ^= 1;
+        }
+
+        output.addFrom(channel, outputStart, source, numOutputSamples);
+    }
+}
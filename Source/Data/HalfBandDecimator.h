@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    HalfBandDecimator.h
+    Created: 18 Oct 2026 7:02:18am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Brings audio rendered at 2, 4 or 8 times the output rate back down: a
+// cascade of half-band FIR stages, each halving the rate. A half-band filter
+// is symmetric and has every other tap zero, and each stage only computes the
+// samples it keeps, so a stage with 4K - 1 taps costs K + 1 multiplies per
+// sample it outputs. The stage nearest the output rate is long, the earlier
+// ones only guard the band that survives it, so they are short.
+//
+// Every stage rejects about 80 dB and passes everything up to 0.42 of the
+// output rate (20 kHz at 48 kHz). Linear phase, so the latency is fixed.
+class HalfBandDecimator
+{
+public:
+    static constexpr int maxFactor = 8;
+
+    // factor is 1, 2, 4 or 8; 1 passes audio straight through. Allocates.
+    void prepare(int factor, int numChannels, int maxOutputSamples);
+    void reset();
+
+    int getFactor() const noexcept { return factor; }
+
+    // Group delay in output samples; 0 at 1x
+    double getLatency() const noexcept { return latency; }
+
+    // Decimates numOutputSamples * factor samples from the start of input and
+    // adds the result to output. Audio thread safe.
+    void process(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output,
+                 int outputStart, int numOutputSamples) noexcept;
+
+private:
+    struct Stage
+    {
+        std::vector<float> coefficients;    // The nonzero side taps, nearest the centre first
+        int centre = 0;                     // Taps either side of the 0.5 centre tap
+
+        // Per channel: the last 2 * centre input samples, followed by the block
+        std::vector<std::vector<float>> work;
+
+        void design(int numSideTaps);
+        void process(int channel, const float* input, float* output, int numOutputSamples) noexcept;
+    };
+
+    // Ordered from the highest rate down
+    std::vector<Stage> stages;
+
+    // Between stages, per channel
+    juce::AudioBuffer<float> intermediate[2];
+
+    int factor = 1;
+    double latency = 0.0;
+};
@@ -10,6 +10,94 @@
 
 #include "OscData.h"
 
+//==============================================================================
+// Vectorised LF pulse for GlottalOscillator::process()/processVoices()
+//
+// Error bound: for the same phase and parameters the vector pulse differs from
+// generateLFPulse() by less than 2e-6 absolute (sin polynomial < 6e-8, exp
+// polynomial < 1e-6 relative on a value <= 1, plus float rounding). process()
+// accumulates phase once per vector instead of once per sample, so over long
+// runs its phase drifts from the scalar path's by float rounding, well below
+// anything audible; processVoices() accumulates per sample exactly like
+// getNextSample(). Breath noise comes from a separate generator in the block
+// path, so it is only statistically equal to the scalar noise.
+//==============================================================================
+namespace
+{
+    using FloatVec = juce::dsp::SIMDRegister<float>;
+    using MaskVec = FloatVec::vMaskType;
+    constexpr int vecSize = static_cast<int>(FloatVec::SIMDNumElements);
+    
+    inline FloatVec select(MaskVec mask, FloatVec a, FloatVec b)
+    {
+        // One side is always +0, so the sum is exactly the selected value
+        return (a & mask) + (b & ~mask);
+    }
+    
+    // sin(pi * x) for x in [-1, 3): fold into [-0.5, 0.5] and use the Taylor
+    // series up to y^11, which is accurate to 6e-8 there
+    inline FloatVec sinPi(FloatVec x)
+    {
+        const auto one = FloatVec::expand(1.0f);
+        x = x - (FloatVec::expand(2.0f) & FloatVec::greaterThanOrEqual(x, one));
+        
+        const auto upper = FloatVec::greaterThan(x, FloatVec::expand(0.5f));
+        const auto lower = FloatVec::lessThan(x, FloatVec::expand(-0.5f));
+        x = select(upper, one - x, select(lower, FloatVec::expand(-1.0f) - x, x));
+        
+        const auto y = x * juce::MathConstants<float>::pi;
+        const auto y2 = y * y;
+        auto p = FloatVec::expand(-2.5052108e-8f);
+        p = p * y2 + 2.7557319e-6f;
+        p = p * y2 - 1.9841270e-4f;
+        p = p * y2 + 8.3333333e-3f;
+        p = p * y2 - 1.6666667e-1f;
+        p = p * y2 + 1.0f;
+        return y * p;
+    }
+    
+    // exp(x) for x in [-4, 0]: degree 7 Taylor series of exp(x / 8), raised to
+    // the 8th power. Relative error < 1e-6.
+    inline FloatVec expNegative(FloatVec x)
+    {
+        const auto z = x * 0.125f;
+        auto p = FloatVec::expand(1.0f / 5040.0f);
+        p = p * z + (1.0f / 720.0f);
+        p = p * z + (1.0f / 120.0f);
+        p = p * z + (1.0f / 24.0f);
+        p = p * z + (1.0f / 6.0f);
+        p = p * z + 0.5f;
+        p = p * z + 1.0f;
+        p = p * z + 1.0f;
+        p = p * p;
+        p = p * p;
+        return p * p;
+    }
+    
+    // LF pulse shape for one set of lanes, broadcast or per voice
+    struct PulseShape
+    {
+        FloatVec te, openQuotient, tp, invTp, invFall, asymmetry;
+    };
+    
+    // Same segments as GlottalOscillator::generateLFPulse(). Within each
+    // segment the polynomial arguments stay inside their valid ranges:
+    // phase / tp < 2.5, and (phase - tp) / (te - tp) is in [1, 1.72) so
+    // exp sees at most -2 * 1.72.
+    inline FloatVec lfPulse(FloatVec phase, const PulseShape& shape)
+    {
+        const auto rising = sinPi(phase * shape.invTp);
+        
+        const auto t = (phase - shape.tp) * shape.invFall;
+        const auto falling = expNegative(FloatVec::expand(0.0f) - shape.asymmetry * t) * sinPi(t + 0.5f);
+        
+        const auto isRising = FloatVec::lessThan(phase, shape.te);
+        const auto isOpen = FloatVec::lessThan(phase, shape.openQuotient);
+        return select(isRising, rising, falling & isOpen);
+    }
+}
+
+
 //==============================================================================
 // GlottalOscillator Implementation
 //==============================================================================
@@ -17,7 +105,24 @@
 void GlottalOscillator::prepare(const juce::dsp::ProcessSpec& spec)
 {
     this->sampleRate = static_cast<float>(spec.sampleRate);
+    
+    // Resetting snaps every ramp to its target
+    openQuotientSmoother.reset(spec.sampleRate, smoothingTime);
+    asymmetrySmoother.reset(spec.sampleRate, smoothingTime);
+    breathinessSmoother.reset(spec.sampleRate, smoothingTime);
+    tensenessSmoother.reset(spec.sampleRate, smoothingTime);
+    
+    openQuotient = openQuotientSmoother.getCurrentValue();
+    asymmetryCoeff = asymmetrySmoother.getCurrentValue();
+    breathiness = breathinessSmoother.getCurrentValue();
+    tenseness = tensenessSmoother.getCurrentValue();
+    
     updateLFParameters();
+    blockNoiseState = static_cast<juce::uint32>(random.nextInt()) | 1u;
+    
+    if (wavetablesEnabled)
+        acquireWavetables();
+    
     isPrepared = true;
 }
 
@@ -25,35 +130,127 @@ void GlottalOscillator::setFrequency(float freq)
 {
     frequency = freq;
     phaseIncrement = frequency / sampleRate;
+    
+    mipLevel = GlottalWavetableBank::getMipLevel(phaseIncrement);
+    updateTableSelection();
+}
+
+void GlottalOscillator::setWavetablesEnabled(bool enabled)
+{
+    wavetablesEnabled = enabled;
+    wavetables = nullptr;
+    
+    if (wavetablesEnabled)
+        acquireWavetables();
+}
+
+void GlottalOscillator::acquireWavetables()
+{
+    // Stays nullptr (analytic pulse) until the background build is done
+    wavetables = wavetableCache->getBank();
+    
+    if (wavetables != nullptr)
+        updateTableSelection();
+}
+
+void GlottalOscillator::updateTableSelection()
+{
+    if (wavetables == nullptr)
+        return;
+    
+    using Bank = GlottalWavetableBank;
+    
+    const float oqPosition = juce::jlimit(0.0f, static_cast<float>(Bank::numOpenQuotients - 1),
+                                          (openQuotient - Bank::minOpenQuotient) / (Bank::maxOpenQuotient - Bank::minOpenQuotient)
+                                              * (Bank::numOpenQuotients - 1));
+    const float asymPosition = juce::jlimit(0.0f, static_cast<float>(Bank::numAsymmetries - 1),
+                                            (asymmetryCoeff - Bank::minAsymmetry) / (Bank::maxAsymmetry - Bank::minAsymmetry)
+                                                * (Bank::numAsymmetries - 1));
+    
+    const int oq = juce::jmin(static_cast<int>(oqPosition), Bank::numOpenQuotients - 2);
+    const int asym = juce::jmin(static_cast<int>(asymPosition), Bank::numAsymmetries - 2);
+    const float oqFraction = oqPosition - static_cast<float>(oq);
+    const float asymFraction = asymPosition - static_cast<float>(asym);
+    
+    cornerTables[0] = wavetables->getTable(mipLevel, oq, asym);
+    cornerTables[1] = wavetables->getTable(mipLevel, oq + 1, asym);
+    cornerTables[2] = wavetables->getTable(mipLevel, oq, asym + 1);
+    cornerTables[3] = wavetables->getTable(mipLevel, oq + 1, asym + 1);
+    
+    cornerWeights[0] = (1.0f - oqFraction) * (1.0f - asymFraction);
+    cornerWeights[1] = oqFraction * (1.0f - asymFraction);
+    cornerWeights[2] = (1.0f - oqFraction) * asymFraction;
+    cornerWeights[3] = oqFraction * asymFraction;
+}
+
+float GlottalOscillator::lookupPulse(float phase) const
+{
+    const float position = phase * GlottalWavetableBank::tableSize;
+    const int index = juce::jmin(static_cast<int>(position), GlottalWavetableBank::tableSize - 1);
+    const float fraction = position - static_cast<float>(index);
+    
+    float sample = 0.0f;
+    
+    for (int corner = 0; corner < 4; ++corner)
+    {
+        const float* table = cornerTables[corner];
+        sample += cornerWeights[corner] * (table[index] + fraction * (table[index + 1] - table[index]));
+    }
+    
+    return sample;
 }
 
 void GlottalOscillator::setOpenQuotient(float oq)
 {
-    openQuotient = juce::jlimit(0.3f, 0.7f, oq);
-    updateLFParameters();
+    openQuotientSmoother.setTargetValue(juce::jlimit(0.3f, 0.7f, oq));
 }
 
 void GlottalOscillator::setAsymmetryCoeff(float alpha)
 {
-    asymmetryCoeff = juce::jlimit(0.1f, 2.0f, alpha);
-    updateLFParameters();
+    asymmetrySmoother.setTargetValue(juce::jlimit(0.1f, 2.0f, alpha));
 }
 
 void GlottalOscillator::setBreathiness(float breath)
 {
-    breathiness = juce::jlimit(0.0f, 1.0f, breath);
+    breathinessSmoother.setTargetValue(juce::jlimit(0.0f, 1.0f, breath));
 }
 
 void GlottalOscillator::setTenseness(float tension)
 {
-    tenseness = juce::jlimit(0.0f, 1.0f, tension);
+    tensenessSmoother.setTargetValue(juce::jlimit(0.0f, 1.0f, tension));
+}
+
+void GlottalOscillator::advanceSmoothedParameters()
+{
+    // Shape parameters feed te/tp, so only redo those while they move
+    if (openQuotientSmoother.isSmoothing() || asymmetrySmoother.isSmoothing())
+    {
+        openQuotient = openQuotientSmoother.getNextValue();
+        asymmetryCoeff = asymmetrySmoother.getNextValue();
+        updateLFParameters();
+    }
+    else if (openQuotient != openQuotientSmoother.getTargetValue() || asymmetryCoeff != asymmetrySmoother.getTargetValue())
+    {
+        // Stepped (zero ramp time) changes land here
+        openQuotient = openQuotientSmoother.getTargetValue();
+        asymmetryCoeff = asymmetrySmoother.getTargetValue();
+        updateLFParameters();
+    }
+    
+    breathiness = breathinessSmoother.getNextValue();
+    tenseness = tensenessSmoother.getNextValue();
 }
 
 float GlottalOscillator::getNextSample()
 {
     if (!isPrepared) return 0.0f;
 
-    float sample = generateLFPulse(phase);
+    advanceSmoothedParameters();
+    
+    if (wavetables == nullptr && wavetablesEnabled)
+        acquireWavetables();
+
+    float sample = wavetables != nullptr ? lookupPulse(phase) : generateLFPulse(phase);
     
     // Add breathiness (noise component)
     if (breathiness > 0.0f)
@@ -72,6 +269,216 @@ float GlottalOscillator::getNextSample()
     return sample;
 }
 
+bool GlottalOscillator::isSmoothing() const
+{
+    return openQuotientSmoother.isSmoothing() || asymmetrySmoother.isSmoothing()
+        || breathinessSmoother.isSmoothing() || tensenessSmoother.isSmoothing();
+}
+
+float GlottalOscillator::nextBlockNoise()
+{
+    // xorshift32: much cheaper than juce::Random, which the block path would
+    // otherwise spend most of its time in
+    blockNoiseState ^= blockNoiseState << 13;
+    blockNoiseState ^= blockNoiseState >> 17;
+    blockNoiseState ^= blockNoiseState << 5;
+    return static_cast<float>(static_cast<juce::int32>(blockNoiseState)) * (1.0f / 2147483648.0f);
+}
+
+void GlottalOscillator::addBlockNoise(float* output, int numSamples, float gain)
+{
+    if (gain <= 0.0f)
+        return;
+    
+    for (int i = 0; i < numSamples; ++i)
+        output[i] += gain * nextBlockNoise();
+}
+
+void GlottalOscillator::process(float* output, int numSamples)
+{
+    if (!isPrepared)
+    {
+        juce::FloatVectorOperations::clear(output, numSamples);
+        return;
+    }
+    
+    if (wavetables == nullptr && wavetablesEnabled)
+        acquireWavetables();
+    
+    if (wavetables != nullptr)
+    {
+        processFromTables(output, numSamples);
+        return;
+    }
+    
+    int i = 0;
+    
+    // Ramps move te/tp every sample, so they stay on the scalar path
+    while (i < numSamples && isSmoothing())
+        output[i++] = getNextSample();
+    
+    // Vector lanes hold consecutive samples; each lane's phase may wrap at most once
+    if (numSamples - i < vecSize || phaseIncrement * vecSize >= 1.0f)
+    {
+        for (; i < numSamples; ++i)
+            output[i] = getNextSample();
+        
+        return;
+    }
+    
+    // Nothing is ramping: this only picks up stepped changes
+    advanceSmoothedParameters();
+    
+    const float gain = 0.5f + 0.5f * tenseness;
+    const float pulseGain = (1.0f - breathiness) * gain;
+    const float noiseGain = breathiness * gain;
+    
+    const PulseShape shape { FloatVec::expand(te), FloatVec::expand(openQuotient), FloatVec::expand(tp),
+                             FloatVec::expand(1.0f / tp), FloatVec::expand(1.0f / (te - tp)),
+                             FloatVec::expand(asymmetryCoeff) };
+    
+    alignas(64) float ramp[vecSize];
+    alignas(64) float lanes[vecSize];
+    
+    for (int k = 0; k < vecSize; ++k)
+        ramp[k] = static_cast<float>(k) * phaseIncrement;
+    
+    const auto rampVec = FloatVec::fromRawArray(ramp);
+    const auto one = FloatVec::expand(1.0f);
+    const float vectorIncrement = phaseIncrement * vecSize;
+    const int vectorStart = i;
+    
+    for (; i + vecSize <= numSamples; i += vecSize)
+    {
+        auto lanePhase = FloatVec::expand(phase) + rampVec;
+        lanePhase = lanePhase - (one & FloatVec::greaterThanOrEqual(lanePhase, one));
+        
+        (lfPulse(lanePhase, shape) * pulseGain).copyToRawArray(lanes);
+        
+        for (int k = 0; k < vecSize; ++k)
+            output[i + k] = lanes[k];
+        
+        phase += vectorIncrement;
+        if (phase >= 1.0f) phase -= 1.0f;
+    }
+    
+    addBlockNoise(output + vectorStart, i - vectorStart, noiseGain);
+    
+    // Leftover samples that don't fill a vector
+    for (; i < numSamples; ++i)
+        output[i] = getNextSample();
+}
+
+void GlottalOscillator::processFromTables(float* output, int numSamples)
+{
+    int i = 0;
+    
+    // Ramps move the table weights every sample
+    while (i < numSamples && isSmoothing())
+        output[i++] = getNextSample();
+    
+    if (i == numSamples)
+        return;
+    
+    advanceSmoothedParameters();
+    
+    const float gain = 0.5f + 0.5f * tenseness;
+    const float pulseGain = (1.0f - breathiness) * gain;
+    const int tableStart = i;
+    
+    for (; i < numSamples; ++i)
+    {
+        output[i] = lookupPulse(phase) * pulseGain;
+        
+        phase += phaseIncrement;
+        if (phase >= 1.0f) phase -= 1.0f;
+    }
+    
+    addBlockNoise(output + tableStart, numSamples - tableStart, breathiness * gain);
+}
+
+void GlottalOscillator::processVoices(GlottalOscillator* const* oscillators, float* const* outputs,
+                                      int numOscillators, int numSamples)
+{
+    for (int first = 0; first < numOscillators; first += vecSize)
+    {
+        const int numLanes = juce::jmin(vecSize, numOscillators - first);
+        bool steady = numLanes > 1;
+        
+        // Table playback is already a few lookups per sample; lanes only pay
+        // off for the analytic pulse, which is used until the tables are built
+        for (int k = 0; k < numLanes && steady; ++k)
+        {
+            auto* osc = oscillators[first + k];
+            
+            if (osc->wavetables == nullptr && osc->wavetablesEnabled)
+                osc->acquireWavetables();
+            
+            steady = osc->isPrepared && osc->wavetables == nullptr && !osc->isSmoothing() && osc->phaseIncrement < 1.0f;
+        }
+        
+        if (!steady)
+        {
+            for (int k = 0; k < numLanes; ++k)
+                oscillators[first + k]->process(outputs[first + k], numSamples);
+            
+            continue;
+        }
+        
+        // Unused lanes run a silent dummy voice (openQuotient 0 is always closed)
+        alignas(64) float phases[vecSize] = {}, increments[vecSize] = {}, laneTe[vecSize] = {},
+                          laneOpenQuotient[vecSize] = {}, laneTp[vecSize] = {}, invTp[vecSize] = {},
+                          invFall[vecSize] = {}, laneAsymmetry[vecSize] = {}, pulseGain[vecSize] = {};
+        alignas(64) float lanes[vecSize];
+        
+        for (int k = 0; k < numLanes; ++k)
+        {
+            auto* osc = oscillators[first + k];
+            osc->advanceSmoothedParameters();
+            
+            phases[k] = osc->phase;
+            increments[k] = osc->phaseIncrement;
+            laneTe[k] = osc->te;
+            laneOpenQuotient[k] = osc->openQuotient;
+            laneTp[k] = osc->tp;
+            invTp[k] = 1.0f / osc->tp;
+            invFall[k] = 1.0f / (osc->te - osc->tp);
+            laneAsymmetry[k] = osc->asymmetryCoeff;
+            pulseGain[k] = (1.0f - osc->breathiness) * (0.5f + 0.5f * osc->tenseness);
+        }
+        
+        const PulseShape shape { FloatVec::fromRawArray(laneTe), FloatVec::fromRawArray(laneOpenQuotient),
+                                 FloatVec::fromRawArray(laneTp), FloatVec::fromRawArray(invTp),
+                                 FloatVec::fromRawArray(invFall), FloatVec::fromRawArray(laneAsymmetry) };
+        const auto increment = FloatVec::fromRawArray(increments);
+        const auto gain = FloatVec::fromRawArray(pulseGain);
+        const auto one = FloatVec::expand(1.0f);
+        auto lanePhase = FloatVec::fromRawArray(phases);
+        
+        for (int i = 0; i < numSamples; ++i)
+        {
+            (lfPulse(lanePhase, shape) * gain).copyToRawArray(lanes);
+            
+            for (int k = 0; k < numLanes; ++k)
+                outputs[first + k][i] = lanes[k];
+            
+            // Same order of operations as getNextSample(), so the phase matches it exactly
+            lanePhase = lanePhase + increment;
+            lanePhase = lanePhase - (one & FloatVec::greaterThanOrEqual(lanePhase, one));
+        }
+        
+        lanePhase.copyToRawArray(phases);
+        
+        for (int k = 0; k < numLanes; ++k)
+        {
+            auto* osc = oscillators[first + k];
+            osc->phase = phases[k];
+            osc->addBlockNoise(outputs[first + k], numSamples,
+                               osc->breathiness * (0.5f + 0.5f * osc->tenseness));
+        }
+    }
+}
+
 void GlottalOscillator::reset()
 {
     phase = 0.0f;
@@ -108,6 +515,7 @@ void GlottalOscillator::updateLFParameters()
 {
     te = openQuotient * 0.7f; // Approximate relationship
     tp = te * 0.4f; // Peak occurs early in the open phase
+    updateTableSelection();
 }
 
 //==============================================================================
@@ -187,15 +595,14 @@ void OscData::getNextAudioBlock(juce::dsp::AudioBlock<float>& block)
             
         case GLOTTAL:
             {
-                // Process sample by sample, copy to all channels
-                for (size_t sample = 0; sample < block.getNumSamples(); ++sample)
+                // Render once, copy to the other channels
+                const int numSamples = static_cast<int>(block.getNumSamples());
+                auto* first = block.getChannelPointer(0);
+                glottalOsc.process(first, numSamples);
+                
+                for (size_t channel = 1; channel < block.getNumChannels(); ++channel)
                 {
-                    float oscillatorSample = glottalOsc.getNextSample();
-                    
-                    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
-                    {
-                        block.setSample(channel, sample, oscillatorSample);
-                    }
+                    juce::FloatVectorOperations::copy(block.getChannelPointer(channel), first, numSamples);
                 }
             }
             break;
@@ -7,6 +7,7 @@
 */
 #pragma once
 #include <JuceHeader.h>
+#include "GlottalWavetable.h"
 
 // Glottal Oscillator class
 class GlottalOscillator
@@ -21,30 +22,78 @@ public:
     void setBreathiness(float breath); // Controls air noise component (0.0-1.0)
     void setTenseness(float tension); // Controls vocal fold tension (0.0-1.0)
     
+    // Ramp time for the parameters above; 0 steps them like the old code did.
+    // Takes effect on the next prepare().
+    void setSmoothingTime(double seconds) { smoothingTime = seconds; }
+    
+    // Breath noise is randomly seeded unless given a seed here, before prepare()
+    void setNoiseSeed(juce::int64 seed) { random.setSeed(seed); }
+    
     float getNextSample();
     void reset();
     
+    // Plays the pulse from the shared band-limited tables once they are built
+    // (the default), or computes it analytically per sample
+    void setWavetablesEnabled(bool enabled);
+    
+    // Block version of getNextSample(). While the shape parameters are steady
+    // the LF pulse runs on SIMD lanes, several samples at a time; ramps fall
+    // back to the per-sample path. See OscData.cpp for the error bound.
+    void process(float* output, int numSamples);
+    
+    // Renders several oscillators at once, one per SIMD lane, each into its
+    // own output. Oscillators that are ramping are rendered with process().
+    static void processVoices(GlottalOscillator* const* oscillators, float* const* outputs,
+                              int numOscillators, int numSamples);
+    
+    static constexpr double defaultSmoothingTime = 0.02;
+    
 private:
     float generateLFPulse(float phase);
     float generateBreathNoise();
     void updateLFParameters();
+    void advanceSmoothedParameters();
+    bool isSmoothing() const;
+    void acquireWavetables();
+    void updateTableSelection();
+    float lookupPulse(float phase) const;
+    void processFromTables(float* output, int numSamples);
+    float nextBlockNoise();
+    void addBlockNoise(float* output, int numSamples, float gain);
     
     float frequency = 440.0f;
     float sampleRate = 44100.0f;
     float phase = 0.0f;
     float phaseIncrement = 0.0f;
     
-    // LF Model parameters
+    // LF Model parameters (current, per-sample values)
     float openQuotient = 0.6f;
     float asymmetryCoeff = 0.7f;
     float breathiness = 0.1f;
     float tenseness = 0.8f;
     
+    // Linear ramps towards the values last set
+    juce::SmoothedValue<float> openQuotientSmoother { 0.6f };
+    juce::SmoothedValue<float> asymmetrySmoother { 0.7f };
+    juce::SmoothedValue<float> breathinessSmoother { 0.1f };
+    juce::SmoothedValue<float> tensenessSmoother { 0.8f };
+    double smoothingTime = defaultSmoothingTime;
+    
     // Derived parameters
     float te = 0.0f; // Time when flow returns to zero
     float tp = 0.0f; // Time of peak flow
     
+    // Band-limited tables: the four grid corners around the current shape and
+    // their bilinear weights, at the mip level for the current frequency
+    juce::SharedResourcePointer<GlottalWavetableCache> wavetableCache;
+    const GlottalWavetableBank* wavetables = nullptr;
+    bool wavetablesEnabled = true;
+    int mipLevel = 0;
+    const float* cornerTables[4] = {};
+    float cornerWeights[4] = {};
+    
     juce::Random random;
+    juce::uint32 blockNoiseState = 0x9e3779b9u; // xorshift32 for the block path, never 0
     bool isPrepared = false;
 };
 
@@ -74,6 +123,8 @@ public:
     void setAsymmetry(float alpha) { glottalOsc.setAsymmetryCoeff(alpha); }
     void setBreathiness(float breath) { glottalOsc.setBreathiness(breath); }
     void setTenseness(float tension) { glottalOsc.setTenseness(tension); }
+    void setSmoothingTime(double seconds) { glottalOsc.setSmoothingTime(seconds); }
+    void setNoiseSeed(juce::int64 seed) { glottalOsc.setNoiseSeed(seed); }
     
     
 private:
@@ -3,11 +3,12 @@
             See LICENSE for licensing terms (MIT)
  ****************************************************************/
 
-#include <regex>
-#include <vector>
+#include <iterator>
 #include <stdexcept>
+#include <string>
 
 #include "ScalaFile.h"
+#include "ScalaText.h"
 
 enum current_entry_map {
     MAP_SIZE,
@@ -22,79 +23,106 @@ enum current_entry_map {
 
 namespace scala {
 
-    kbm read_kbm(std::ifstream& input_file){
-        std::string buffer;
-        unsigned int current_entry = 0;
+    kbm read_kbm(const char* data, size_t size){
+        text::line_reader lines { data, data + size };
+        const char* line_begin;
+        const char* line_end;
+
+        unsigned int current_entry = MAP_SIZE;
         kbm keyboard_mapping;
 
+        while (lines.next(line_begin, line_end)) {
 #ifdef SCALA_STRICT
-        std::regex COMMENT_REGEX = std::regex("^!.*");
-        std::regex EX = std::regex("^[ \t]*[x]{1}.*");
+            const char* p = line_begin;
 #else
-        std::regex COMMENT_REGEX = std::regex("[ \t]*!.*");
-        std::regex EX = std::regex("^[ \t]*[xX]{1}.*");
+            const char* p = text::skip_space(line_begin, line_end);
 #endif
-    
-        while(input_file){
-            getline(input_file, buffer);
-            if (std::regex_match (buffer, COMMENT_REGEX)) {
+            if (p != line_end && *p == '!') {
                 // Ignore comments
-            } else if (std::regex_match (buffer, std::regex("[ \t]*") )) {
+                continue;
+            }
+
+            if (text::skip_space(p, line_end) == line_end) {
                 // Blank line. If we're in strict mode this means end of file.
                 // Stop parsing.
 #ifdef SCALA_STRICT
                 break;
+#else
+                continue;
+#endif
+            }
+
+            p = text::skip_space(p, line_end);
+            const char* token = text::token_end(p, line_end);
+            bool valid = true;
+
+            switch (current_entry) {
+                case MAP_SIZE:
+                    valid = text::parse_integer(p, token, keyboard_mapping.map_size) && keyboard_mapping.map_size >= 0;
+                    break;
+                case FIRST_NOTE:
+                    valid = text::parse_integer(p, token, keyboard_mapping.first_note);
+                    break;
+                case LAST_NOTE:
+                    valid = text::parse_integer(p, token, keyboard_mapping.last_note);
+                    break;
+                case MIDDLE_NOTE:
+                    valid = text::parse_integer(p, token, keyboard_mapping.middle_note);
+                    break;
+                case REFERENCE_NOTE:
+                    valid = text::parse_integer(p, token, keyboard_mapping.reference_note);
+                    break;
+                case REFERENCE_FREQUENCY:
+                    valid = text::parse_decimal(p, token, keyboard_mapping.reference_frequency);
+                    break;
+                case OCTAVE_DEGREE:
+                    valid = text::parse_integer(p, token, keyboard_mapping.octave_degree);
+                    break;
+                case ACTUAL_MAP: {
+                    if (static_cast <int> (keyboard_mapping.mapping.size()) == keyboard_mapping.map_size) {
+                        // This is an error, strict mode or not
+                        throw std::runtime_error("ERROR: Too many entries in mapping file");
+                    }
+
+                    // An x (either case unless strict) leaves the key unmapped
+                    int entry = KBM_NON_ENTRY;
+#ifdef SCALA_STRICT
+                    const bool non_entry = *p == 'x';
+#else
+                    const bool non_entry = *p == 'x' || *p == 'X';
 #endif
-            } else {
-                switch(current_entry){
-                    case MAP_SIZE: 
-                        keyboard_mapping.map_size = std::stoi(buffer);
-                        current_entry += 1;
-                        break;
-                    case FIRST_NOTE: 
-                        keyboard_mapping.first_note = std::stoi(buffer);
-                        current_entry += 1;
-                        break;
-                    case LAST_NOTE: 
-                        keyboard_mapping.last_note = std::stoi(buffer);
-                        current_entry += 1;
-                        break;
-                    case MIDDLE_NOTE: 
-                        keyboard_mapping.middle_note = std::stoi(buffer);
-                        current_entry += 1;
-                        break;
-                    case REFERENCE_NOTE: 
-                        keyboard_mapping.reference_note = std::stoi(buffer);
-                        current_entry += 1;
-                        break;
-                    case REFERENCE_FREQUENCY: 
-                        keyboard_mapping.reference_frequency = std::stod(buffer);
-                        current_entry += 1;
-                        break;
-                    case OCTAVE_DEGREE: 
-                        keyboard_mapping.octave_degree = std::stoi(buffer);
-                        current_entry += 1;
-                        break;
-                    case ACTUAL_MAP:
-                        // This one is a little more complicated.  If we have an x
-                        if (std::regex_match (buffer, EX)) {
-                            // A non-entry
-                            keyboard_mapping.add_mapping(KBM_NON_ENTRY);
-                        } else {
-                            // A mapping entry
-                            keyboard_mapping.add_mapping(std::stoi(buffer));
-                        }
+                    if (non_entry)
+                        p = token;
+                    else
+                        valid = text::parse_integer(p, token, entry);
+
+                    keyboard_mapping.add_mapping(entry);
                 }
             }
+
+            // Only the first token counts; anything after it is a comment
+            if (! valid || p != token)
+                throw std::runtime_error("ERROR: Cannot read line " + std::to_string(lines.line_number) + " of mapping file");
+
+            if (current_entry == MAP_SIZE)
+                keyboard_mapping.mapping.reserve(static_cast <size_t> (keyboard_mapping.map_size));
+
+            if (current_entry < ACTUAL_MAP)
+                ++current_entry;
         }
+
+        if (current_entry < ACTUAL_MAP)
+            throw std::runtime_error("ERROR: Mapping file header is incomplete");
+
         if (static_cast <size_t> (keyboard_mapping.map_size) != keyboard_mapping.mapping.size()){
-            // This is an error, strict mode or not 
-            if (static_cast <size_t> (keyboard_mapping.map_size) < keyboard_mapping.mapping.size()){
-                throw std::runtime_error("ERROR: Too few entires in mapping file");
-            } else {
-                throw std::runtime_error("ERROR: Too many entires in mapping file");
-            }
+            // This is an error, strict mode or not
+            throw std::runtime_error("ERROR: Too few entries in mapping file");
         }
         return keyboard_mapping;
     }
-}
\ No newline at end of file
+
+    kbm read_kbm(std::ifstream& input_file){
+        const std::string contents { std::istreambuf_iterator<char>(input_file), std::istreambuf_iterator<char>() };
+        return read_kbm(contents.data(), contents.size());
+    }
+}
@@ -3,133 +3,145 @@
             See LICENSE for licensing terms (MIT)
  ****************************************************************/
 
-#include <iostream>
-#include <fstream>
-#include <regex>
-#include <math.h>
+#include <iterator>
 #include <stdexcept>
+#include <string>
 
 #include "ScalaFile.h"
-#include "JuceHeader.h"
+#include "ScalaText.h"
 
 namespace scala {
-    scale read_scl(std::ifstream& input_file){ 
-        /* 
+
+    namespace {
+        std::string line_error(const char* message, int line_number) {
+            return std::string("Scala parse error, line ") + std::to_string(line_number) + ": " + message;
+        }
+
+        // One pitch: n/d or a bare integer is a ratio, anything with a
+        // decimal point is cents. False if the token is neither.
+        bool parse_degree(const char* p, const char* end, double& ratio) {
+            const char* start = p;
+            bool cents = false;
+
+            for (const char* c = p; c != end; ++c)
+                cents = cents || *c == '.';
+
+            if (cents) {
+                double value;
+
+                if (! text::parse_decimal(p, end, value) || p != end)
+                    return false;
+
+                ratio = degree(value).get_ratio();
+                return true;
+            }
+
+            double numerator, denominator = 1.0;
+
+            if (! text::parse_digits(p, end, numerator))
+                return false;
+
+            if (p != end && *p == '/') {
+                ++p;
+
+                if (! text::parse_digits(p, end, denominator) || denominator == 0.0)
+                    return false;
+            }
+
+            ratio = numerator / denominator;
+            return p == end && p != start;
+        }
+    }
+
+    scale read_scl(const char* data, size_t size){
+        /*
         C++ Code to parse the Scala scale file, as documented here:
             http://www.huygens-fokker.org/scala/scl_format.html
+
+        The first non-comment line is the description, even when blank, the
+        second the number of notes, then one pitch per line up to that many.
+        Anything on a line after the first token is a label and ignored.
         */
-        
-        int non_comments_processed = 0;  // Fixed typo: non_commnets -> non_comments
-        unsigned long entries = 0;
-        int numerator, denominator;
-        std::string buffer;
-        std::smatch match, trimmed;
+
+        text::line_reader lines { data, data + size };
+        const char* line_begin;
+        const char* line_end;
+
         scale scala_scale;
         bool description_parsed = false;
+        bool count_parsed = false;
+        int entries = 0;
+        int degrees_parsed = 0;
+
+        while (degrees_parsed < entries || ! count_parsed) {
+            if (! lines.next(line_begin, line_end))
+                break;
 
+            const char* p = text::skip_space(line_begin, line_end);
+
+            if (p != line_end && *p == '!')
+                continue;
+
+            if (! description_parsed) {
+                const char* trimmed_end = line_end;
+
+                while (trimmed_end != p && text::is_space(trimmed_end[-1]))
+                    --trimmed_end;
+
+                scala_scale.description.assign(p, trimmed_end);
+                description_parsed = true;
+                continue;
+            }
+
+            if (p == line_end) {
+                // Blank lines are tolerated, except in strict mode
 #ifdef SCALA_STRICT
-        std::regex COMMENT_REGEX = std::regex(R"(^\s*!.*)");
+                throw std::runtime_error(line_error("unexpected blank line", lines.line_number));
 #else
-        std::regex COMMENT_REGEX = std::regex(R"(^\s*!.*)");
+                continue;
 #endif
+            }
 
-        while (std::getline(input_file, buffer)) {
-            DBG("Processing line: '" + juce::String(buffer) + "'");
-            
-            // Trim trailing whitespace and newlines
-            buffer.erase(buffer.find_last_not_of(" \t\r\n") + 1);
-            
-            if (std::regex_match(buffer, COMMENT_REGEX)) {
-                DBG("-> Comment line");
-                continue;  // Skip comment lines entirely
-            } 
-            else if (buffer.empty() || std::regex_match(buffer, std::regex(R"(^\s*$)"))) {
-                DBG("-> Blank line");
-                // Handle blank lines
-#ifdef SCALA_STRICT
-                if (description_parsed && non_comments_processed > 1) {
-                    // If we're past the header and hit a blank line, we're done
-                    break;
-                }
-#endif
-                continue;  // Skip blank lines
-            } 
-            else {
-                DBG("-> Content line");
-                // Extract the part after optional leading whitespace and before optional trailing content
-                std::regex_search(buffer, trimmed, std::regex(R"(^\s*([^\s]+).*)"));
-                std::string entry = trimmed.size() > 1 ? trimmed[1] : buffer;
-                DBG("Extracted entry: '" + juce::String(entry) + "'");
-                
-                if (non_comments_processed == 0) {
-                    DBG("-> Description line");
-                    // First non-comment is the description
-                    description_parsed = true;
-                    non_comments_processed++;
-                    continue;
-                }
-                else if (non_comments_processed == 1) {
-                    // Second non-comment line contains the number of entries
-                    DBG("Parsing entry count: '" + juce::String(entry) + "'");
-                    try {
-                        entries = std::stoul(entry);
-                        DBG("Successfully parsed entries: " + juce::String((int)entries));
-                    } catch (const std::exception& e) {
-                        DBG("Failed to parse entry count '" + juce::String(entry) + "': " + juce::String(e.what()));
-                        throw;
-                    }
-                    non_comments_processed++;
-                    continue;
-                }
-                
-                // Parse scale degrees
-                if (std::regex_match(entry, std::regex(R"(.*/.+)"))) {
-                    // A ratio (e.g., "3/2", "5/4")
-                    std::regex_search(entry, match, std::regex(R"((\d+)/(\d+))"));
-                    if (match.size() >= 3) {
-                        numerator = std::stoi(match.str(1)); 
-                        denominator = std::stoi(match.str(2)); 
-                        scala_scale.add_degree(*new degree(numerator, denominator));
-                        DBG("Added ratio: " + juce::String(numerator) + "/" + juce::String(denominator));
-                    }
-                }
-                else if (std::regex_match(entry, std::regex(R"(\d*\.\d+)"))) {
-                    // Cent values with decimal point (e.g., "100.0", "272.727")
-                    double cents = std::stod(entry);
-                    scala_scale.add_degree(*new degree(cents));
-                    DBG("Added cents: " + juce::String(cents));
-                }
-                else if (std::regex_match(entry, std::regex(R"(^\d+$)"))) {
-                    // Integer values treated as ratios (e.g., "2" becomes "2/1")
-                    numerator = std::stoi(entry); 
-                    denominator = 1;
-                    scala_scale.add_degree(*new degree(numerator, denominator));
-                    DBG("Added integer ratio: " + juce::String(numerator) + "/1");
-                }
+            const char* token = text::token_end(p, line_end);
+
+            if (! count_parsed) {
+                if (! text::parse_integer(p, token, entries) || p != token || entries < 0)
+                    throw std::runtime_error(line_error("bad note count", lines.line_number));
+
+                scala_scale.degrees.reserve(static_cast <size_t> (entries) + 1);
+                count_parsed = true;
+                continue;
+            }
+
+            double ratio;
+
+            if (parse_degree(p, token, ratio) && ratio > 0.0) {
+                scala_scale.degrees.emplace_back(ratio, 1.0);
+                ++degrees_parsed;
+            } else {
 #ifdef SCALA_STRICT
-                else {
-                    // In strict mode, throw an error if the line can't be interpreted
-                    std::string message = "Scala parse error: cannot interpret: ";
-                    throw std::runtime_error(message.append(buffer));
-                }
-#else
-                else {
-                    DBG("Skipping unrecognized entry: '" + juce::String(entry) + "'");
-                }
+                throw std::runtime_error(line_error("cannot interpret pitch", lines.line_number));
 #endif
-                non_comments_processed++;
+                // Otherwise skip it, as Scala itself does
             }
         }
-        
+
+        if (! count_parsed)
+            throw std::runtime_error("Scala parse error: missing note count");
+
 #ifdef SCALA_STRICT
-        if (scala_scale.get_scale_length() != entries + 1) {
+        if (degrees_parsed != entries) {
             // Check that we parsed the expected number of entries
-            throw std::runtime_error("Scala file parse error: Unexpected number of entries. Expected: " + 
-                                    std::to_string(entries + 1) + ", Got: " + 
-                                    std::to_string(scala_scale.get_scale_length()));
+            throw std::runtime_error("Scala file parse error: Unexpected number of entries. Expected: " +
+                                     std::to_string(entries) + ", Got: " + std::to_string(degrees_parsed));
         }
 #endif
-        
+
         return scala_scale;
     }
-} // namespace scala
\ No newline at end of file
+
+    scale read_scl(std::ifstream& input_file){
+        const std::string contents { std::istreambuf_iterator<char>(input_file), std::istreambuf_iterator<char>() };
+        return read_scl(contents.data(), contents.size());
+    }
+} // namespace scala
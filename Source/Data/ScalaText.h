@@ -0,0 +1,121 @@
+/****************************************************************
+          libscala-file, (C) 2020 Mark Conway Wirt
+            See LICENSE for licensing terms (MIT)
+ ****************************************************************/
+#pragma once
+
+// Scanning helpers shared by the .scl and .kbm parsers. Everything works on
+// [begin, end) ranges of the file in memory: no copies, no allocation, and
+// no reliance on a terminating null, so mapped files parse in place.
+
+namespace scala {
+namespace text {
+
+    inline bool is_space(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+    }
+
+    inline bool is_digit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    inline const char* skip_space(const char* p, const char* end) {
+        while (p != end && is_space(*p))
+            ++p;
+        return p;
+    }
+
+    inline const char* token_end(const char* p, const char* end) {
+        while (p != end && ! is_space(*p))
+            ++p;
+        return p;
+    }
+
+    // Hands out one line at a time, without its line ending
+    struct line_reader {
+        const char* position;
+        const char* end;
+        int line_number = 0;
+
+        bool next(const char*& line_begin, const char*& line_end) {
+            if (position == end)
+                return false;
+
+            line_begin = position;
+
+            while (position != end && *position != '\n')
+                ++position;
+
+            line_end = position;
+
+            if (position != end)
+                ++position;
+
+            while (line_end != line_begin && line_end[-1] == '\r')
+                --line_end;
+
+            ++line_number;
+            return true;
+        }
+    };
+
+    // Unsigned digits only. Accumulates in a double so the huge numerators
+    // some just intonation scales use don't overflow.
+    inline bool parse_digits(const char*& p, const char* end, double& value) {
+        const char* start = p;
+        value = 0.0;
+
+        while (p != end && is_digit(*p))
+            value = value * 10.0 + (*p++ - '0');
+
+        return p != start;
+    }
+
+    inline bool parse_integer(const char*& p, const char* end, int& value) {
+        bool negative = false;
+
+        if (p != end && (*p == '-' || *p == '+'))
+            negative = *p++ == '-';
+
+        double magnitude;
+
+        if (! parse_digits(p, end, magnitude) || magnitude > 2147483647.0)
+            return false;
+
+        value = static_cast <int> (negative ? -magnitude : magnitude);
+        return true;
+    }
+
+    // [sign] digits [. [digits]] or [sign] . digits
+    inline bool parse_decimal(const char*& p, const char* end, double& value) {
+        bool negative = false;
+
+        if (p != end && (*p == '-' || *p == '+'))
+            negative = *p++ == '-';
+
+        double whole = 0.0, fraction = 0.0, scale = 1.0;
+        const bool has_whole = parse_digits(p, end, whole);
+        bool has_fraction = false;
+
+        if (p != end && *p == '.') {
+            ++p;
+
+            while (p != end && is_digit(*p)) {
+                fraction = fraction * 10.0 + (*p++ - '0');
+                scale *= 10.0;
+                has_fraction = true;
+            }
+        }
+
+        if (! has_whole && ! has_fraction)
+            return false;
+
+        value = whole + fraction / scale;
+
+        if (negative)
+            value = -value;
+
+        return true;
+    }
+}
+}
@@ -0,0 +1,302 @@
+/*
+  ==============================================================================
+
+    ScaleLibrary.cpp
+    Created: 18 Oct 2026 4:38:11am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "ScaleLibrary.h"
+
+namespace
+{
+    // Index file: magic, version, the directories, then per file its path,
+    // modification time, size, description and degree ratios (none for files
+    // that failed to parse). Written with MemoryOutputStream, so little-endian.
+    constexpr int indexMagic = 0x49534f58;  // "ISOX"
+    constexpr int indexVersion = 1;
+
+    bool isOctave(double periodCents)
+    {
+        return std::abs(periodCents - 1200.0) < 1.0e-6;
+    }
+}
+
+//==============================================================================
+ScaleLibrary::ScaleLibrary()
+    : BackgroundScanner("ISODRONE scale library")
+    , indexFile(juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                    .getChildFile("ISODRONE").getChildFile("ScaleIndex.dat"))
+{
+    directories.add(getDefaultDirectory());
+    startScanning();
+}
+
+ScaleLibrary::~ScaleLibrary()
+{
+    stopScanning();
+}
+
+juce::File ScaleLibrary::getDefaultDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+               .getChildFile("ISODRONE").getChildFile("Scales");
+}
+
+juce::Array<juce::File> ScaleLibrary::getDirectories() const
+{
+    const juce::ScopedLock sl(lock);
+    return directories;
+}
+
+void ScaleLibrary::setDirectories(const juce::Array<juce::File>& directoriesToScan)
+{
+    {
+        const juce::ScopedLock sl(lock);
+        directories = directoriesToScan;
+        directoriesChosen = true;
+    }
+
+    rescan();
+}
+
+//==============================================================================
+std::vector<int> ScaleLibrary::search(const Entries& entriesToSearch, const Filter& filter)
+{
+    auto words = juce::StringArray::fromTokens(filter.text, " \t", {});
+    words.removeEmptyStrings();
+
+    std::vector<int> matches;
+
+    for (int e = 0; e < static_cast<int>(entriesToSearch.size()); ++e)
+    {
+        const auto& entry = entriesToSearch[static_cast<size_t>(e)];
+
+        if (entry.numNotes < filter.minNotes || entry.numNotes > filter.maxNotes
+            || (filter.octaveOnly && ! isOctave(entry.periodCents)))
+            continue;
+
+        const bool matchesText = std::all_of(words.begin(), words.end(), [&entry] (const juce::String& word)
+        {
+            return entry.name.containsIgnoreCase(word) || entry.description.containsIgnoreCase(word);
+        });
+
+        if (matchesText)
+            matches.push_back(e);
+    }
+
+    return matches;
+}
+
+int ScaleLibrary::indexOf(const Entries& entriesToSearch, const juce::File& file)
+{
+    for (int e = 0; e < static_cast<int>(entriesToSearch.size()); ++e)
+        if (entriesToSearch[static_cast<size_t>(e)].file == file)
+            return e;
+
+    return -1;
+}
+
+//==============================================================================
+void ScaleLibrary::prepareScan()
+{
+    // What was indexed last time is usable straight away; the scan then
+    // only has to catch up with changes
+    loadIndex();
+    publishPlayable();
+}
+
+void ScaleLibrary::scan()
+{
+    if (scanFiles())
+        saveIndex();
+
+    publishPlayable();
+}
+
+bool ScaleLibrary::scanFiles()
+{
+    // Previous results by path, to be reused for files that haven't changed
+    std::map<juce::String, const ScaleLibraryEntry*> previous;
+
+    for (const auto& entry : indexed)
+        previous[entry.file.getFullPathName()] = &entry;
+
+    Entries next;
+    bool changed = false;
+
+    for (const auto& directory : getDirectories())
+    {
+        for (const auto& child : juce::RangedDirectoryIterator(directory, true, "*.scl", juce::File::findFiles))
+        {
+            if (shouldStopScanning())
+                return false;
+
+            const auto& file = child.getFile();
+            const auto found = previous.find(file.getFullPathName());
+
+            if (found != previous.end()
+                && found->second->modificationTime == child.getModificationTime().toMilliseconds()
+                && found->second->fileSize == child.getFileSize())
+            {
+                next.push_back(*found->second);
+                previous.erase(found);
+                continue;
+            }
+
+            auto entry = parseFile(file);
+            entry.modificationTime = child.getModificationTime().toMilliseconds();
+            entry.fileSize = child.getFileSize();
+            next.push_back(std::move(entry));
+            changed = true;
+        }
+    }
+
+    // Anything left over was deleted or is no longer under a directory
+    changed = changed || ! previous.empty();
+    indexed = std::move(next);
+    return changed;
+}
+
+ScaleLibraryEntry ScaleLibrary::parseFile(const juce::File& file)
+{
+    ScaleLibraryEntry entry;
+    entry.file = file;
+    entry.name = file.getFileNameWithoutExtension();
+
+    juce::MemoryMappedFile mapped(file, juce::MemoryMappedFile::readOnly);
+
+    if (mapped.getData() == nullptr)
+        return entry;
+
+    try
+    {
+        auto scale = scala::read_scl(static_cast<const char*>(mapped.getData()), mapped.getSize());
+
+        if (scale.get_scale_length() > 1)
+        {
+            entry.description = juce::String::fromUTF8(scale.description.c_str());
+            entry.numNotes = static_cast<int>(scale.get_scale_length()) - 1;
+            entry.periodCents = 1200.0 * std::log2(scale.degrees.back().get_ratio());
+            entry.scale = std::make_shared<const scala::scale>(std::move(scale));
+        }
+    }
+    catch (const std::exception&)
+    {
+        // Stays in the index as unplayable, so it isn't parsed again until it changes
+    }
+
+    return entry;
+}
+
+void ScaleLibrary::publishPlayable()
+{
+    auto playable = std::make_shared<Entries>();
+
+    for (const auto& entry : indexed)
+        if (entry.scale != nullptr)
+            playable->push_back(entry);
+
+    std::sort(playable->begin(), playable->end(), [] (const ScaleLibraryEntry& a, const ScaleLibraryEntry& b)
+    {
+        return a.name.compareNatural(b.name, false) < 0;
+    });
+
+    publish(std::move(playable));
+}
+
+//==============================================================================
+void ScaleLibrary::loadIndex()
+{
+    juce::MemoryBlock data;
+
+    if (! indexFile.loadFileAsData(data))
+        return;
+
+    juce::MemoryInputStream stream(data, false);
+
+    if (stream.readInt() != indexMagic || stream.readInt() != indexVersion)
+        return;
+
+    juce::Array<juce::File> savedDirectories;
+
+    for (int d = stream.readInt(); d > 0 && ! stream.isExhausted(); --d)
+        savedDirectories.add(juce::File(stream.readString()));
+
+    Entries loaded;
+
+    for (int e = stream.readInt(); e > 0 && ! stream.isExhausted(); --e)
+    {
+        ScaleLibraryEntry entry;
+        entry.file = juce::File(stream.readString());
+        entry.name = entry.file.getFileNameWithoutExtension();
+        entry.modificationTime = stream.readInt64();
+        entry.fileSize = stream.readInt64();
+        entry.description = stream.readString();
+
+        const int numDegrees = stream.readInt();
+
+        // A truncated or corrupt index is thrown away whole and rebuilt
+        if (numDegrees < 0 || stream.getNumBytesRemaining() < numDegrees * static_cast<juce::int64>(sizeof(double)))
+            return;
+
+        if (numDegrees > 1)
+        {
+            scala::scale scale;
+            scale.description = entry.description.toStdString();
+            scale.degrees.clear();
+            scale.degrees.reserve(static_cast<size_t>(numDegrees));
+
+            for (int d = 0; d < numDegrees; ++d)
+                scale.degrees.emplace_back(stream.readDouble(), 1.0);
+
+            entry.numNotes = numDegrees - 1;
+            entry.periodCents = 1200.0 * std::log2(scale.degrees.back().get_ratio());
+            entry.scale = std::make_shared<const scala::scale>(std::move(scale));
+        }
+
+        loaded.push_back(std::move(entry));
+    }
+
+    indexed = std::move(loaded);
+
+    // Unless they were changed before the index got loaded
+    const juce::ScopedLock sl(lock);
+
+    if (! savedDirectories.isEmpty() && ! directoriesChosen)
+        directories = savedDirectories;
+}
+
+void ScaleLibrary::saveIndex() const
+{
+    juce::MemoryOutputStream stream;
+    stream.writeInt(indexMagic);
+    stream.writeInt(indexVersion);
+
+    const auto directoriesToSave = getDirectories();
+    stream.writeInt(directoriesToSave.size());
+
+    for (const auto& directory : directoriesToSave)
+        stream.writeString(directory.getFullPathName());
+
+    stream.writeInt(static_cast<int>(indexed.size()));
+
+    for (const auto& entry : indexed)
+    {
+        stream.writeString(entry.file.getFullPathName());
+        stream.writeInt64(entry.modificationTime);
+        stream.writeInt64(entry.fileSize);
+        stream.writeString(entry.description);
+
+        const int numDegrees = entry.scale != nullptr ? static_cast<int>(entry.scale->get_scale_length()) : 0;
+        stream.writeInt(numDegrees);
+
+        for (int d = 0; d < numDegrees; ++d)
+            stream.writeDouble(entry.scale->get_ratio(static_cast<size_t>(d)));
+    }
+
+    indexFile.getParentDirectory().createDirectory();
+    indexFile.replaceWithData(stream.getData(), stream.getDataSize());
+}
@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    ScaleLibrary.h
+    Created: 18 Oct 2026 4:38:11am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ScalaFile.h"
+#include "../Utility/BackgroundScanner.h"
+
+// One .scl file of the library, parsed once and kept in memory so switching
+// to it never touches the disk
+struct ScaleLibraryEntry
+{
+    juce::File file;
+    juce::String name;                          // File name without extension
+    juce::String description;
+    int numNotes = 0;
+    double periodCents = 0.0;                   // 1200 for octave repeating scales
+    juce::int64 modificationTime = 0;
+    juce::int64 fileSize = 0;
+    std::shared_ptr<const scala::scale> scale;  // nullptr if the file didn't parse
+};
+
+// Every Scala scale under a set of directories, indexed on a background
+// thread. The index is kept on disk with each file's modification time and
+// size, so a restart only parses files that are new or changed; the rest
+// come back from the index, degrees and all. Editors listen for new entries
+// to refill the scale chooser. One per process, through a
+// SharedResourcePointer.
+class ScaleLibrary : public BackgroundScanner<std::vector<ScaleLibraryEntry>>
+{
+public:
+    using Entries = std::vector<ScaleLibraryEntry>;
+
+    ScaleLibrary();
+    ~ScaleLibrary() override;
+
+    // <user application data>/ISODRONE/Scales, scanned until told otherwise
+    static juce::File getDefaultDirectory();
+
+    // Scanned recursively for .scl files. Setting them starts a rescan and
+    // they are remembered in the index.
+    juce::Array<juce::File> getDirectories() const;
+    void setDirectories(const juce::Array<juce::File>& directoriesToScan);
+
+    // Every playable scale, sorted by name, for as long as it's held
+    std::shared_ptr<const Entries> getEntries() const { return getSnapshot(); }
+
+    struct Filter
+    {
+        juce::String text;          // Every word must appear in the name or description
+        int minNotes = 0;
+        int maxNotes = std::numeric_limits<int>::max();
+        bool octaveOnly = false;    // Only scales that repeat at 2/1
+
+        bool isEmpty() const { return text.isEmpty() && minNotes <= 0 && maxNotes == std::numeric_limits<int>::max() && ! octaveOnly; }
+    };
+
+    // Indices into entries of the scales that match, in library order
+    static std::vector<int> search(const Entries& entries, const Filter& filter);
+
+    // Index of the entry for file, or -1
+    static int indexOf(const Entries& entries, const juce::File& file);
+
+private:
+    void prepareScan() override;
+    void scan() override;
+    void loadIndex();
+    void saveIndex() const;
+    bool scanFiles();
+    void publishPlayable();
+
+    static ScaleLibraryEntry parseFile(const juce::File& file);
+
+    mutable juce::CriticalSection lock;     // Guards the directories
+    juce::Array<juce::File> directories;
+    bool directoriesChosen = false;
+
+    // Scan thread only: every indexed file, including ones that failed to
+    // parse, so they aren't retried until they change
+    Entries indexed;
+    juce::File indexFile;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScaleLibrary)
+};
@@ -0,0 +1,297 @@
+/*
+  ==============================================================================
+
+    TuningArchive.cpp
+    Created: 18 Oct 2026 3:05:18am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "TuningArchive.h"
+
+namespace
+{
+    // Binary layout: Header, numEntries EntryRecords, numValues doubles, then
+    // a pool of null terminated UTF-8 strings. Headers and records are
+    // multiples of 8 bytes, so the doubles stay aligned in the mapping.
+    struct Header
+    {
+        char magic[4];
+        juce::uint32 version;
+        juce::uint32 numEntries;
+        juce::uint32 numValues;
+    };
+
+    constexpr char magic[4] = { 'I', 'S', 'O', 'T' };
+    constexpr juce::uint32 formatVersion = 1;
+}
+
+// A scale's values are its ratios, 1/1 included; a mapping's are its key to
+// degree map, -1 for unmapped keys
+struct TuningArchive::EntryRecord
+{
+    double referenceFrequency;
+    juce::uint32 kind;
+    juce::uint32 nameOffset;
+    juce::uint32 descriptionOffset;
+    juce::uint32 firstValue;
+    juce::uint32 numValues;
+    juce::int32 mapSize;
+    juce::int32 firstNote;
+    juce::int32 lastNote;
+    juce::int32 middleNote;
+    juce::int32 referenceNote;
+    juce::int32 octaveDegree;
+    juce::uint32 reserved;
+};
+
+//==============================================================================
+TuningArchive::TuningArchive(std::unique_ptr<juce::MemoryMappedFile> mappedFile)
+    : mapped(std::move(mappedFile))
+    , data(static_cast<const char*>(mapped->getData()))
+    , dataSize(mapped->getSize())
+{
+    static_assert(sizeof(Header) == 16 && sizeof(EntryRecord) == 56,
+                  "TuningArchive records must match the file format");
+}
+
+std::unique_ptr<TuningArchive> TuningArchive::loadFromFile(const juce::File& file, juce::String& error)
+{
+    if (juce::ByteOrder::isBigEndian())
+    {
+        error = "tuning archives are little-endian only";
+        return nullptr;
+    }
+
+    auto mappedFile = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+
+    if (mappedFile->getData() == nullptr)
+    {
+        error = "could not open " + file.getFullPathName();
+        return nullptr;
+    }
+
+    std::unique_ptr<TuningArchive> archive(new TuningArchive(std::move(mappedFile)));
+
+    if (! archive->index(error))
+        return nullptr;
+
+    return archive;
+}
+
+bool TuningArchive::isArchive(const juce::File& file)
+{
+    juce::FileInputStream stream(file);
+    char fileMagic[sizeof(magic)];
+
+    return stream.openedOk() && stream.read(fileMagic, sizeof(fileMagic)) == sizeof(fileMagic)
+        && std::memcmp(fileMagic, magic, sizeof(magic)) == 0;
+}
+
+bool TuningArchive::index(juce::String& error)
+{
+    if (dataSize < sizeof(Header) || std::memcmp(data, magic, sizeof(magic)) != 0)
+    {
+        error = "not a tuning archive";
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+
+    if (header.version != formatVersion)
+    {
+        error = "unsupported tuning archive version " + juce::String(header.version);
+        return false;
+    }
+
+    const size_t valuesOffset = sizeof(Header) + static_cast<size_t>(header.numEntries) * sizeof(EntryRecord);
+    const size_t stringsOffset = valuesOffset + static_cast<size_t>(header.numValues) * sizeof(double);
+
+    if (header.numEntries > static_cast<juce::uint32>(std::numeric_limits<int>::max()) || stringsOffset > dataSize)
+    {
+        error = "truncated tuning archive";
+        return false;
+    }
+
+    records = reinterpret_cast<const EntryRecord*>(data + sizeof(Header));
+    values = reinterpret_cast<const double*>(data + valuesOffset);
+    numValues = header.numValues;
+    strings = data + stringsOffset;
+    stringsSize = dataSize - stringsOffset;
+
+    // Check every record once here, so lookups can trust them
+    for (juce::uint32 e = 0; e < header.numEntries; ++e)
+    {
+        const auto& record = records[e];
+        const bool isScale = record.kind == static_cast<juce::uint32>(Kind::scale);
+        const bool isMapping = record.kind == static_cast<juce::uint32>(Kind::keyboardMapping);
+
+        if ((! isScale && ! isMapping)
+            || record.firstValue > numValues || record.numValues > numValues - record.firstValue
+            || (isScale && record.numValues == 0)
+            || (isMapping && static_cast<juce::int64>(record.numValues) != record.mapSize)
+            || record.nameOffset >= stringsSize || record.descriptionOffset >= stringsSize)
+        {
+            error = "corrupt tuning archive entry " + juce::String(e);
+            return false;
+        }
+    }
+
+    // Strings are read with fromUTF8 up to their terminator, so the pool must end in one
+    if (stringsSize > 0 && strings[stringsSize - 1] != '\0')
+    {
+        error = "corrupt tuning archive strings";
+        return false;
+    }
+
+    numEntries = static_cast<int>(header.numEntries);
+    return true;
+}
+
+//==============================================================================
+const TuningArchive::EntryRecord& TuningArchive::getRecord(int entryIndex) const noexcept
+{
+    jassert(juce::isPositiveAndBelow(entryIndex, numEntries));
+    return records[entryIndex];
+}
+
+juce::String TuningArchive::getString(juce::uint32 offset) const
+{
+    return juce::String::fromUTF8(strings + offset);
+}
+
+TuningArchive::Kind TuningArchive::getKind(int entryIndex) const noexcept
+{
+    return static_cast<Kind>(getRecord(entryIndex).kind);
+}
+
+juce::String TuningArchive::getName(int entryIndex) const
+{
+    return getString(getRecord(entryIndex).nameOffset);
+}
+
+juce::String TuningArchive::getDescription(int entryIndex) const
+{
+    return getString(getRecord(entryIndex).descriptionOffset);
+}
+
+int TuningArchive::findFirst(Kind kind) const noexcept
+{
+    for (int e = 0; e < numEntries; ++e)
+        if (getKind(e) == kind)
+            return e;
+
+    return -1;
+}
+
+scala::scale TuningArchive::getScale(int entryIndex) const
+{
+    const auto& record = getRecord(entryIndex);
+    jassert(record.kind == static_cast<juce::uint32>(Kind::scale));
+
+    scala::scale scale;
+    scale.description = getDescription(entryIndex).toStdString();
+    scale.degrees.clear();
+    scale.degrees.reserve(record.numValues);
+
+    for (juce::uint32 v = 0; v < record.numValues; ++v)
+        scale.degrees.emplace_back(values[record.firstValue + v], 1.0);
+
+    return scale;
+}
+
+scala::kbm TuningArchive::getKeyboardMapping(int entryIndex) const
+{
+    const auto& record = getRecord(entryIndex);
+    jassert(record.kind == static_cast<juce::uint32>(Kind::keyboardMapping));
+
+    scala::kbm mapping;
+    mapping.reference_frequency = record.referenceFrequency;
+    mapping.map_size = record.mapSize;
+    mapping.first_note = record.firstNote;
+    mapping.last_note = record.lastNote;
+    mapping.middle_note = record.middleNote;
+    mapping.reference_note = record.referenceNote;
+    mapping.octave_degree = record.octaveDegree;
+    mapping.mapping.reserve(record.numValues);
+
+    for (juce::uint32 v = 0; v < record.numValues; ++v)
+        mapping.add_mapping(static_cast<int>(values[record.firstValue + v]));
+
+    return mapping;
+}
+
+//==============================================================================
+void TuningArchive::Builder::addScale(const juce::String& name, const scala::scale& scale)
+{
+    PendingEntry entry { Kind::scale, name, juce::String::fromUTF8(scale.description.c_str()), {}, {} };
+
+    for (const auto& degree : scale.degrees)
+        entry.values.push_back(degree.get_ratio());
+
+    entries.push_back(std::move(entry));
+}
+
+void TuningArchive::Builder::addKeyboardMapping(const juce::String& name, const scala::kbm& mapping)
+{
+    PendingEntry entry { Kind::keyboardMapping, name, {}, {}, mapping };
+
+    for (auto degree : mapping.mapping)
+        entry.values.push_back(static_cast<double>(degree));
+
+    entries.push_back(std::move(entry));
+}
+
+bool TuningArchive::Builder::writeTo(const juce::File& file) const
+{
+    std::vector<EntryRecord> records;
+    std::vector<double> values;
+    juce::MemoryOutputStream strings;
+
+    const auto addString = [&strings] (const juce::String& text)
+    {
+        const auto offset = static_cast<juce::uint32>(strings.getDataSize());
+        strings.write(text.toRawUTF8(), text.getNumBytesAsUTF8() + 1);
+        return offset;
+    };
+
+    for (const auto& entry : entries)
+    {
+        EntryRecord record {};
+        record.kind = static_cast<juce::uint32>(entry.kind);
+        record.nameOffset = addString(entry.name);
+        record.descriptionOffset = addString(entry.description);
+        record.firstValue = static_cast<juce::uint32>(values.size());
+        record.numValues = static_cast<juce::uint32>(entry.values.size());
+
+        if (entry.kind == Kind::keyboardMapping)
+        {
+            record.referenceFrequency = entry.mapping.reference_frequency;
+            record.mapSize = entry.mapping.map_size;
+            record.firstNote = entry.mapping.first_note;
+            record.lastNote = entry.mapping.last_note;
+            record.middleNote = entry.mapping.middle_note;
+            record.referenceNote = entry.mapping.reference_note;
+            record.octaveDegree = entry.mapping.octave_degree;
+        }
+
+        values.insert(values.end(), entry.values.begin(), entry.values.end());
+        records.push_back(record);
+    }
+
+    Header header;
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = formatVersion;
+    header.numEntries = static_cast<juce::uint32>(records.size());
+    header.numValues = static_cast<juce::uint32>(values.size());
+
+    juce::MemoryBlock block;
+    block.append(&header, sizeof(header));
+    block.append(records.data(), records.size() * sizeof(EntryRecord));
+    block.append(values.data(), values.size() * sizeof(double));
+    block.append(strings.getData(), strings.getDataSize());
+
+    return file.replaceWithData(block.getData(), block.getSize());
+}
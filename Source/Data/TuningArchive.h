@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    TuningArchive.h
+    Created: 18 Oct 2026 3:05:18am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ScalaFile.h"
+
+// Scales and keyboard mappings compiled ahead of time. The file is memory
+// mapped and read in place: opening one is a single mmap and a header check,
+// and an entry is turned into a scala::scale or scala::kbm by copying its
+// numbers, with no text to parse. ISODRONEScalaCompiler builds them from a
+// directory of .scl and .kbm files; a single scale compiles to a one entry
+// archive.
+class TuningArchive
+{
+public:
+    static constexpr const char* fileExtension = ".isotun";
+
+    enum class Kind
+    {
+        scale,
+        keyboardMapping
+    };
+
+    // nullptr and error filled in if the file isn't a valid archive
+    static std::unique_ptr<TuningArchive> loadFromFile(const juce::File& file, juce::String& error);
+
+    // True if the file starts with the archive magic, without mapping it
+    static bool isArchive(const juce::File& file);
+
+    int getNumEntries() const noexcept { return numEntries; }
+    Kind getKind(int index) const noexcept;
+
+    // The source file name without extension, and the .scl description line
+    juce::String getName(int index) const;
+    juce::String getDescription(int index) const;
+
+    // Index of the first entry of a kind, -1 if there is none
+    int findFirst(Kind kind) const noexcept;
+
+    // The entry must be of the matching kind
+    scala::scale getScale(int index) const;
+    scala::kbm getKeyboardMapping(int index) const;
+
+    // Collects entries in memory, then writes them out in one go
+    class Builder
+    {
+    public:
+        void addScale(const juce::String& name, const scala::scale& scale);
+        void addKeyboardMapping(const juce::String& name, const scala::kbm& mapping);
+
+        int getNumEntries() const noexcept { return static_cast<int>(entries.size()); }
+        bool writeTo(const juce::File& file) const;
+
+    private:
+        struct PendingEntry
+        {
+            Kind kind;
+            juce::String name, description;
+            std::vector<double> values;
+            scala::kbm mapping;
+        };
+
+        std::vector<PendingEntry> entries;
+    };
+
+private:
+    explicit TuningArchive(std::unique_ptr<juce::MemoryMappedFile> mappedFile);
+    bool index(juce::String& error);
+
+    struct EntryRecord;
+    const EntryRecord& getRecord(int index) const noexcept;
+    juce::String getString(juce::uint32 offset) const;
+
+    std::unique_ptr<juce::MemoryMappedFile> mapped;
+    const char* data = nullptr;
+    size_t dataSize = 0;
+    int numEntries = 0;
+    const EntryRecord* records = nullptr;
+    const double* values = nullptr;
+    juce::uint32 numValues = 0;
+    const char* strings = nullptr;
+    size_t stringsSize = 0;
+};
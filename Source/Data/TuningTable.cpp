@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    TuningTable.cpp
+    Created: 18 Oct 2026 1:12:07am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "TuningTable.h"
+
+namespace
+{
+    // Floor division and modulo, so keys below the middle note wrap downwards
+    int floorDivide(int value, int divisor)
+    {
+        return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+    }
+
+    int wrap(int value, int divisor)
+    {
+        return value - floorDivide(value, divisor) * divisor;
+    }
+
+    // Ratios of one scale period: 1/1 first, the period (the last degree) last
+    std::vector<double> getRatios(const scala::scale* scale)
+    {
+        std::vector<double> ratios;
+
+        if (scale != nullptr && scale->degrees.size() > 1)
+        {
+            for (const auto& degree : scale->degrees)
+                ratios.push_back(degree.ratio);
+        }
+        else
+        {
+            for (int step = 0; step <= 12; ++step)
+                ratios.push_back(std::pow(2.0, step / 12.0));
+        }
+
+        return ratios;
+    }
+}
+
+TuningTable::TuningTable(const scala::scale* scale, const scala::kbm* mapping)
+{
+    const auto ratios = getRatios(scale);
+    const int scaleSize = static_cast<int>(ratios.size()) - 1;
+    const double period = ratios.back();
+    
+    // A kbm without a reference frequency is as good as none
+    const bool hasMapping = mapping != nullptr && mapping->reference_frequency > 0.0;
+    const int mapSize = hasMapping ? mapping->map_size : 0;
+    const int firstNote = hasMapping ? mapping->first_note : 0;
+    const int lastNote = hasMapping ? mapping->last_note : numNotes - 1;
+    const int middleNote = hasMapping ? mapping->middle_note : 60;
+    const int referenceNote = hasMapping ? mapping->reference_note : 69;
+    const double referenceFrequency = hasMapping ? mapping->reference_frequency : 440.0;
+    
+    // The degree the mapping repeats at, 0 meaning the scale's own period
+    const int octaveDegree = hasMapping && mapping->octave_degree > 0 ? mapping->octave_degree : scaleSize;
+    
+    // Scale degree of a key relative to the middle note; false if unmapped
+    auto getDegree = [&] (int key, int& degree)
+    {
+        const int offset = key - middleNote;
+        
+        if (mapSize <= 0)
+        {
+            degree = offset;
+            return true;
+        }
+        
+        const int entry = mapping->mapping[static_cast<size_t>(wrap(offset, mapSize))];
+        
+        if (entry == KBM_NON_ENTRY)
+            return false;
+        
+        degree = entry + floorDivide(offset, mapSize) * octaveDegree;
+        return true;
+    };
+    
+    // Degrees past the period climb by whole periods
+    auto getRatio = [&] (int degree)
+    {
+        return std::pow(period, floorDivide(degree, scaleSize)) * ratios[static_cast<size_t>(wrap(degree, scaleSize))];
+    };
+    
+    // The reference key fixes the middle note's frequency. An unmapped
+    // reference key still has a position in the pattern, so fall back to
+    // counting keys linearly from the middle note.
+    int referenceDegree = 0;
+    
+    if (! getDegree(referenceNote, referenceDegree))
+        referenceDegree = referenceNote - middleNote;
+    
+    const double middleFrequency = referenceFrequency / getRatio(referenceDegree);
+    
+    for (int key = 0; key < numNotes; ++key)
+    {
+        int degree = 0;
+        double frequency = 0.0;
+        
+        if (key >= firstNote && key <= lastNote && getDegree(key, degree))
+            frequency = middleFrequency * getRatio(degree);
+        
+        frequencies[static_cast<size_t>(key)] = static_cast<float>(frequency);
+    }
+}
+
+//==============================================================================
+TuningState::TuningState(const scala::scale* scaleToUse, const scala::kbm* mappingToUse)
+    : TuningState(scaleToUse != nullptr ? std::make_shared<const scala::scale>(*scaleToUse) : nullptr, mappingToUse)
+{
+}
+
+TuningState::TuningState(std::shared_ptr<const scala::scale> scaleToUse, const scala::kbm* mappingToUse)
+    : scale(std::move(scaleToUse))
+    , hasKeyboardMapping(mappingToUse != nullptr)
+    , table(scale.get(), mappingToUse)
+{
+    if (mappingToUse != nullptr)
+        keyboardMapping = *mappingToUse;
+}
@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    TuningTable.h
+    Created: 18 Oct 2026 1:12:07am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ScalaFile.h"
+
+// The frequency of every MIDI key under a Scala scale and keyboard mapping,
+// computed once per load so note lookups on the audio thread are a single
+// array read. Follows the .kbm semantics in full: map size (0 for a linear
+// mapping), first and last retuned key, middle note, reference note and
+// frequency, formal octave degree and unmapped ('x') keys.
+class TuningTable
+{
+public:
+    static constexpr int numNotes = 128;
+    
+    // Either may be nullptr for Scala's defaults: 12-TET, middle note 60,
+    // A 69 = 440 Hz
+    TuningTable(const scala::scale* scale = nullptr, const scala::kbm* mapping = nullptr);
+    
+    // 0 for keys the mapping leaves unmapped
+    float getFrequency(int midiNote) const noexcept
+    {
+        return frequencies[static_cast<size_t>(juce::jlimit(0, numNotes - 1, midiNote))];
+    }
+    
+    bool isMapped(int midiNote) const noexcept { return getFrequency(midiNote) > 0.0f; }
+    
+private:
+    std::array<float, numNotes> frequencies;
+};
+
+// One complete tuning: the scale and mapping it was built from and the
+// table they give. Never modified once built; MidiProcessor swaps in a
+// whole new one, so the audio thread can't see a half-loaded tuning. The
+// scale is shared rather than copied, so tunings built from ScaleLibrary
+// entries reuse the library's preloaded degrees.
+struct TuningState
+{
+    // 12-TET, nothing loaded
+    TuningState() = default;
+    
+    TuningState(const scala::scale* scaleToUse, const scala::kbm* mappingToUse);
+    TuningState(std::shared_ptr<const scala::scale> scaleToUse, const scala::kbm* mappingToUse);
+    
+    // True if notes need retuning at all
+    bool retunes() const noexcept { return scale != nullptr || hasKeyboardMapping; }
+    
+    const scala::scale* getScale() const noexcept { return scale.get(); }
+    const scala::kbm* getKeyboardMapping() const noexcept { return hasKeyboardMapping ? &keyboardMapping : nullptr; }
+    
+    std::shared_ptr<const scala::scale> scale;
+    scala::kbm keyboardMapping;
+    bool hasKeyboardMapping = false;
+    TuningTable table;
+};
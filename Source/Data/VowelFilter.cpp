@@ -10,24 +10,10 @@
 
 #include "VowelFilter.h"
 
-// Formant data for each vowel (frequencies in Hz, bandwidths in Hz, gains linear)
-const VowelFilter::FormantData VowelFilter::vowelFormants[NumVowels] = {
-    // A vowel
-    { 730.0f, 1090.0f, 2440.0f, 80.0f, 90.0f, 120.0f, 1.5f, 1.0f, 0.5f },
-    // E vowel  
-    { 530.0f, 1840.0f, 2480.0f, 80.0f, 90.0f, 120.0f, 1.5f, 1.2f, 0.6f },
-    // I vowel
-    { 270.0f, 2290.0f, 3010.0f, 40.0f, 90.0f, 120.0f, 1.2f, 1.5f, 0.8f },
-    // O vowel
-    { 570.0f, 840.0f, 2410.0f, 80.0f, 80.0f, 120.0f, 1.5f, 0.8f, 0.5f },
-    // U vowel
-    { 440.0f, 1020.0f, 2240.0f, 80.0f, 80.0f, 120.0f, 1.2f, 0.6f, 0.4f }
-};
-
 VowelFilter::VowelFilter()
     : sampleRate(44100.0)
     , numChannels(2)
-    , currentVowel(E)
+    , vowelPosition(getVowelPosition(E))
     , currentFundamental(220.0f)
     , referenceFundamental(220.0f)
     , formantShift(1.0f)
@@ -36,37 +22,43 @@ VowelFilter::VowelFilter()
     , resonanceGain(1.0f)
     , harmonicAlignment(false)
 {
+    // Classic, the first built-in set, until told otherwise
+    formantSet = &formantLibrary->getLibrary()->getSet(0);
+    numFormants = formantSet->numFormants;
+    
+    updateLog2Terms();
+    updateVowelMorph();
 }
 
 VowelFilter::~VowelFilter()
 {
 }
 
-void VowelFilter::prepareToPlay(double newSampleRate, int samplesPerBlock)
+void VowelFilter::prepareToPlay(double newSampleRate, int samplesPerBlock, int newNumChannels)
 {
     sampleRate = newSampleRate;
+    numChannels = newNumChannels;
     
     if (numChannels == 0)
         numChannels = 2;
     
-    // Clear and resize filter arrays
-    formant1Filters.clear();
-    formant2Filters.clear();
-    formant3Filters.clear();
+    updateLog2Terms();
     
-    // Create filters for each channel
-    for (int channel = 0; channel < numChannels; ++channel)
-    {
-        formant1Filters.push_back(std::make_unique<juce::IIRFilter>());
-        formant2Filters.push_back(std::make_unique<juce::IIRFilter>());
-        formant3Filters.push_back(std::make_unique<juce::IIRFilter>());
-    }
+    // Filter state for every formant of every channel, cleared
+    formantBank.prepare(numChannels, maxFormants);
+    formantBank.setActiveFormants(numFormants);
     
-    // Configure filters with current vowel formants
+    // Ramps are counted in coefficient sub-blocks
+    rampSubBlocks = juce::roundToInt(smoothingTime * sampleRate / coefficientSubBlock);
+    resonanceGainSmoother.reset(sampleRate, smoothingTime);
+    resonanceGainSmoother.setCurrentAndTargetValue(resonanceGain);
+    
+    // Configure filters with current vowel formants, without ramping
+    coefficientsInitialised = false;
     updateFilters();
     
-    // Prepare temporary buffer for parallel processing
-    tempBuffer.setSize(numChannels, samplesPerBlock, false, true, true);
+    // The bank runs in place on the caller's buffer, so block size needs no storage
+    juce::ignoreUnused(samplesPerBlock);
 }
 
 void VowelFilter::process(juce::AudioBuffer<float>& buffer)
@@ -80,89 +72,111 @@ void VowelFilter::process(juce::AudioBuffer<float>& buffer)
         return; // No signal to process, avoid filter artifacts
     }
     
-    // Update channel count if needed
-    if (channels != numChannels)
-    {
-        numChannels = channels;
-        prepareToPlay(sampleRate, numSamples);
-    }
-    
-    // Ensure temp buffer is the right size
-    tempBuffer.setSize(channels, numSamples, false, false, true);
-    tempBuffer.clear();
+    // The filter bank is sized in prepareToPlay; re-preparing here would allocate
+    jassert(channels <= numChannels);
     
-    // Create temporary arrays for each formant processing
-    juce::AudioBuffer<float> formant1Buffer(channels, numSamples);
-    juce::AudioBuffer<float> formant2Buffer(channels, numSamples);
-    juce::AudioBuffer<float> formant3Buffer(channels, numSamples);
+    // Single pass, in place: every input sample goes through all formant
+    // sections, which are summed, scaled, clipped and written straight back.
+    // Coefficients step between sub-blocks, the gain ramps per sample.
+    float gains[coefficientSubBlock];
     
-    // Copy input to each formant buffer
-    formant1Buffer.makeCopyOf(buffer, true);
-    formant2Buffer.makeCopyOf(buffer, true);
-    formant3Buffer.makeCopyOf(buffer, true);
-    
-    // Process each formant buffer
-    for (int channel = 0; channel < channels; ++channel)
-    {
-        formant1Filters[channel]->processSamples(formant1Buffer.getWritePointer(channel), numSamples);
-        formant2Filters[channel]->processSamples(formant2Buffer.getWritePointer(channel), numSamples);
-        formant3Filters[channel]->processSamples(formant3Buffer.getWritePointer(channel), numSamples);
-    }
-    
-    // Sum all formant outputs into the temp buffer
-    for (int channel = 0; channel < channels; ++channel)
+    for (int start = 0; start < numSamples; start += coefficientSubBlock)
     {
-        auto* outputData = tempBuffer.getWritePointer(channel);
-        auto* formant1Data = formant1Buffer.getReadPointer(channel);
-        auto* formant2Data = formant2Buffer.getReadPointer(channel);
-        auto* formant3Data = formant3Buffer.getReadPointer(channel);
+        const int subBlockSamples = juce::jmin(coefficientSubBlock, numSamples - start);
+        advanceCoefficientRamp();
         
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            // Sum all formant outputs
-            float filteredSample = formant1Data[sample] + formant2Data[sample] + formant3Data[sample];
-            
-            // Apply overall gain scaling with resonance control
-            filteredSample *= (0.7f * resonanceGain);
-            
-            // Soft clipping for safety
-            filteredSample = juce::jlimit(-0.95f, 0.95f, filteredSample);
-            
-            outputData[sample] = filteredSample;
-        }
+        // Overall gain scaling with resonance control, shared by all channels
+        for (int i = 0; i < subBlockSamples; ++i)
+            gains[i] = 0.7f * resonanceGainSmoother.getNextValue();
+        
+        for (int channel = 0; channel < channels; ++channel)
+            formantBank.process(channel, buffer.getWritePointer(channel, start), subBlockSamples, gains);
     }
-    
-    // Copy the filtered result back to the main buffer
-    buffer.makeCopyOf(tempBuffer, true);
 }
 
 void VowelFilter::reset()
 {
-    for (auto& filter : formant1Filters)
-        if (filter) filter->reset();
-        
-    for (auto& filter : formant2Filters)
-        if (filter) filter->reset();
-        
-    for (auto& filter : formant3Filters)
-        if (filter) filter->reset();
+    formantBank.reset();
 }
 
 // Main controls
 void VowelFilter::setVowelType(VowelType vowel)
 {
-    if (currentVowel != vowel)
+    setVowelPosition(getVowelPosition(vowel));
+}
+
+void VowelFilter::setVowelPosition(juce::Point<float> position)
+{
+    position = { juce::jlimit(0.0f, 1.0f, position.x), juce::jlimit(0.0f, 1.0f, position.y) };
+    
+    if (vowelPosition != position)
     {
-        currentVowel = vowel;
+        vowelPosition = position;
+        updateVowelMorph();
         updateFilters();
     }
 }
 
+void VowelFilter::setFormantSet(const FormantSet* set)
+{
+    if (set == nullptr || set == formantSet)
+        return;
+    
+    const bool countChanged = set->numFormants != numFormants;
+    formantSet = set;
+    numFormants = set->numFormants;
+    
+    if (formantBank.getNumFormants() == maxFormants)
+        formantBank.setActiveFormants(numFormants);
+    
+    // Sections that just appeared have nothing to glide from, so a new
+    // formant count switches over directly; the bank starts them from rest,
+    // so they fade in through their own response instead of releasing old state
+    if (countChanged)
+        coefficientsInitialised = false;
+    
+    updateLog2Terms();
+    updateVowelMorph();
+    updateFilters();
+}
+
+juce::Point<float> VowelFilter::getVowelPosition(VowelType vowel)
+{
+    switch (vowel)
+    {
+        case I: return { 0.0f, 0.0f };
+        case U: return { 1.0f, 0.0f };
+        case E: return { 0.0f, 0.5f };
+        case O: return { 1.0f, 0.5f };
+        case A: 
+        default: return { 0.5f, 1.0f };
+    }
+}
+
+VowelFilter::VowelType VowelFilter::getVowelType() const
+{
+    VowelType nearest = A;
+    
+    for (int v = 0; v < NumVowels; ++v)
+    {
+        const auto vowel = static_cast<VowelType>(v);
+        
+        if (vowelPosition.getDistanceSquaredFrom(getVowelPosition(vowel))
+            < vowelPosition.getDistanceSquaredFrom(getVowelPosition(nearest)))
+            nearest = vowel;
+    }
+    
+    return nearest;
+}
+
 void VowelFilter::setFundamentalFrequency(float frequency)
 {
     if (std::abs(frequency - currentFundamental) > 1.0f && frequency > 50.0f && frequency < 2000.0f)
     {
         currentFundamental = frequency;
+        
+        // Formants follow the pitch by its fourth root
+        log2PitchScale = 0.25f * std::log2(currentFundamental / referenceFundamental);
         updateFilters();
     }
 }
@@ -174,6 +188,7 @@ void VowelFilter::setFormantShift(float shiftFactor)
     if (std::abs(formantShift - shiftFactor) > 0.01f)
     {
         formantShift = shiftFactor;
+        updateLog2Terms();
         updateFilters();
     }
 }
@@ -184,6 +199,7 @@ void VowelFilter::setFormantSpread(float spreadFactor)
     if (std::abs(formantSpread - spreadFactor) > 0.01f)
     {
         formantSpread = spreadFactor;
+        updateLog2Terms();
         updateFilters();
     }
 }
@@ -194,6 +210,7 @@ void VowelFilter::setBandwidthScale(float bandwidthFactor)
     if (std::abs(bandwidthScale - bandwidthFactor) > 0.01f)
     {
         bandwidthScale = bandwidthFactor;
+        updateLog2Terms();
         updateFilters();
     }
 }
@@ -202,6 +219,7 @@ void VowelFilter::setResonanceGain(float gainFactor)
 {
     resonanceGain = juce::jlimit(0.1f, 2.0f, gainFactor);
     // No need to update filters, this is applied in real-time during processing
+    resonanceGainSmoother.setTargetValue(resonanceGain);
 }
 
 void VowelFilter::setHarmonicAlignment(bool enabled)
@@ -213,6 +231,56 @@ void VowelFilter::setHarmonicAlignment(bool enabled)
     }
 }
 
+void VowelFilter::setParameters(juce::Point<float> newVowelPosition, float shiftFactor, float spreadFactor,
+                                float bandwidthFactor, float gainFactor, bool alignToHarmonics)
+{
+    bool needsUpdate = false;
+    
+    // Vowel sweeps land here every block, so moving the position alone
+    // doesn't recompute the log terms
+    newVowelPosition = { juce::jlimit(0.0f, 1.0f, newVowelPosition.x), juce::jlimit(0.0f, 1.0f, newVowelPosition.y) };
+    const bool needsMorph = vowelPosition != newVowelPosition;
+    vowelPosition = newVowelPosition;
+    
+    shiftFactor = juce::jlimit(0.5f, 2.0f, shiftFactor);
+    if (std::abs(formantShift - shiftFactor) > 0.01f)
+    {
+        formantShift = shiftFactor;
+        needsUpdate = true;
+    }
+    
+    spreadFactor = juce::jlimit(0.5f, 2.0f, spreadFactor);
+    if (std::abs(formantSpread - spreadFactor) > 0.01f)
+    {
+        formantSpread = spreadFactor;
+        needsUpdate = true;
+    }
+    
+    bandwidthFactor = juce::jlimit(0.5f, 3.0f, bandwidthFactor);
+    if (std::abs(bandwidthScale - bandwidthFactor) > 0.01f)
+    {
+        bandwidthScale = bandwidthFactor;
+        needsUpdate = true;
+    }
+    
+    if (harmonicAlignment != alignToHarmonics)
+    {
+        harmonicAlignment = alignToHarmonics;
+        needsUpdate = true;
+    }
+    
+    setResonanceGain(gainFactor);
+    
+    if (needsUpdate)
+        updateLog2Terms();
+    
+    if (needsMorph)
+        updateVowelMorph();
+    
+    if (needsUpdate || needsMorph)
+        updateFilters();
+}
+
 // Internal methods
 float VowelFilter::findNearestHarmonic(float formantFreq, float fundamental)
 {
@@ -224,89 +292,168 @@ float VowelFilter::findNearestHarmonic(float formantFreq, float fundamental)
     return fundamental * harmonicNumber;
 }
 
-float VowelFilter::applyFormantAdjustments(float baseFrequency, int formantIndex)
+void VowelFilter::updateLog2Terms()
 {
-    float adjustedFreq = baseFrequency;
-    
-    // Apply pitch-based scaling
-    if (currentFundamental > 0.0f)
+    for (int f = 0; f < numFormants; ++f)
     {
-        float pitchRatio = currentFundamental / referenceFundamental;
-        adjustedFreq *= std::pow(pitchRatio, 0.25f);
+        // Spread higher formants more; past the third the spread could cross
+        // zero, so it bottoms out at two octaves down
+        log2Spread[f] = std::log2(juce::jmax(0.25f, 1.0f + (formantSpread - 1.0f) * (f / 2.0f)));
     }
     
-    // Apply global formant shift
-    adjustedFreq *= formantShift;
+    log2Shift = std::log2(formantShift);
+    log2BandwidthScale = std::log2(bandwidthScale);
+    log2SampleRate = static_cast<float>(std::log2(sampleRate));
+    log2MaxFrequency = static_cast<float>(std::log2(sampleRate * 0.4));
+}
+
+void VowelFilter::updateVowelMorph()
+{
+    const FormantVowel* vowels = formantSet->vowels;
     
-    // Apply formant spreading (spread higher formants more)
-    if (formantIndex > 0)
+    // Inverse distance weighting, 1 / d^4, over every vowel of the set.
+    // Blending in the log domain morphs frequencies and bandwidths
+    // geometrically; sitting on a vowel's point gives exactly that vowel.
+    float weights[FormantSet::maxVowels];
+    const int numVowels = formantSet->numVowels;
+    float totalWeight = 0.0f;
+    
+    for (int v = 0; v < numVowels; ++v)
     {
-        float spreadAmount = 1.0f + (formantSpread - 1.0f) * (formantIndex / 2.0f);
-        adjustedFreq *= spreadAmount;
+        const float dx = vowelPosition.x - vowels[v].x;
+        const float dy = vowelPosition.y - vowels[v].y;
+        const float distanceSquared = dx * dx + dy * dy;
+        
+        if (distanceSquared < 1.0e-8f)
+        {
+            for (int f = 0; f < numFormants; ++f)
+            {
+                log2VowelFrequency[f] = vowels[v].log2Frequency[f];
+                log2VowelBandwidth[f] = vowels[v].log2Bandwidth[f];
+                vowelGain[f] = vowels[v].gain[f];
+            }
+            
+            return;
+        }
+        
+        weights[v] = 1.0f / (distanceSquared * distanceSquared);
+        totalWeight += weights[v];
     }
     
-    // Apply harmonic alignment if enabled
-    if (harmonicAlignment && currentFundamental > 0.0f)
+    for (int f = 0; f < numFormants; ++f)
     {
-        adjustedFreq = findNearestHarmonic(adjustedFreq, currentFundamental);
+        float frequency = 0.0f, bandwidth = 0.0f, gain = 0.0f;
+        
+        for (int v = 0; v < numVowels; ++v)
+        {
+            frequency += weights[v] * vowels[v].log2Frequency[f];
+            bandwidth += weights[v] * vowels[v].log2Bandwidth[f];
+            gain += weights[v] * vowels[v].gain[f];
+        }
+        
+        log2VowelFrequency[f] = frequency / totalWeight;
+        log2VowelBandwidth[f] = bandwidth / totalWeight;
+        vowelGain[f] = gain / totalWeight;
     }
+}
+
+float VowelFilter::applyFormantAdjustments(float log2BaseFrequency, int formantIndex)
+{
+    // Pitch scaling, global shift and spread
+    float log2Frequency = log2BaseFrequency + log2PitchScale + log2Shift + log2Spread[formantIndex];
     
-    // Ensure reasonable limits
-    adjustedFreq = juce::jlimit(baseFrequency * 0.5f, baseFrequency * 2.5f, adjustedFreq);
+    // Harmonic alignment is the one adjustment that needs Hz
+    if (harmonicAlignment && currentFundamental > 0.0f)
+    {
+        log2Frequency = std::log2(findNearestHarmonic(std::exp2(log2Frequency), currentFundamental));
+    }
     
-    return adjustedFreq;
+    // Ensure reasonable limits: half to two and a half times the base frequency
+    return juce::jlimit(log2BaseFrequency - 1.0f, log2BaseFrequency + 1.321928f, log2Frequency);
 }
 
 void VowelFilter::updateFilters()
 {
-    const FormantData& formant = vowelFormants[currentVowel];
+    // One set of target sections per formant, shared by all channels
+    for (int f = 0; f < numFormants; ++f)
+        targetSections[f] = makeSectionParameters(applyFormantAdjustments(log2VowelFrequency[f], f),
+                                                  log2VowelBandwidth[f] + log2BandwidthScale, vowelGain[f]);
     
-    // Update each formant filter for all channels
-    for (int channel = 0; channel < static_cast<int>(formant1Filters.size()); ++channel)
+    if (! coefficientsInitialised || rampSubBlocks == 0)
     {
-        if (formant1Filters[channel])
-        {
-            float freq = applyFormantAdjustments(formant.f1, 0);
-            float bw = formant.bw1 * bandwidthScale;
-            createBandpassFilter(formant1Filters[channel].get(), freq, bw, formant.gain1);
-        }
-            
-        if (formant2Filters[channel])
-        {
-            float freq = applyFormantAdjustments(formant.f2, 1);
-            float bw = formant.bw2 * bandwidthScale;
-            createBandpassFilter(formant2Filters[channel].get(), freq, bw, formant.gain2);
-        }
-            
-        if (formant3Filters[channel])
-        {
-            float freq = applyFormantAdjustments(formant.f3, 2);
-            float bw = formant.bw3 * bandwidthScale;
-            createBandpassFilter(formant3Filters[channel].get(), freq, bw, formant.gain3);
-        }
+        // Nothing sounding yet, or smoothing disabled: jump straight there
+        for (int f = 0; f < numFormants; ++f)
+            currentSections[f] = targetSections[f];
+        
+        rampSubBlocksRemaining = 0;
+        coefficientsInitialised = formantBank.getNumFormants() > 0;
+        applyCurrentCoefficients();
+        return;
     }
+    
+    // Otherwise glide from wherever we are now. The sections are state
+    // variable filters, so any path through frequency and Q is stable.
+    const float subBlocks = static_cast<float>(rampSubBlocks);
+    
+    for (int f = 0; f < numFormants; ++f)
+    {
+        sectionSteps[f].log2Frequency = (targetSections[f].log2Frequency - currentSections[f].log2Frequency) / subBlocks;
+        sectionSteps[f].k = (targetSections[f].k - currentSections[f].k) / subBlocks;
+        sectionSteps[f].gain = (targetSections[f].gain - currentSections[f].gain) / subBlocks;
+    }
+    
+    rampSubBlocksRemaining = rampSubBlocks;
 }
 
-void VowelFilter::createBandpassFilter(juce::IIRFilter* filter, float frequency, float bandwidth, float gain)
+void VowelFilter::advanceCoefficientRamp()
 {
-    // Ensure frequency is within valid range
-    frequency = juce::jlimit(50.0f, static_cast<float>(sampleRate * 0.4), frequency);
-    bandwidth = juce::jlimit(20.0f, frequency * 0.5f, bandwidth);
+    if (rampSubBlocksRemaining <= 0)
+        return;
     
-    // Convert bandwidth to Q factor: Q = frequency / bandwidth
-    float q = frequency / bandwidth;
-    q = juce::jlimit(0.7f, 8.0f, q);
+    if (--rampSubBlocksRemaining == 0)
+    {
+        // Land exactly on the target rather than accumulating rounding error
+        for (int f = 0; f < numFormants; ++f)
+            currentSections[f] = targetSections[f];
+    }
+    else
+    {
+        for (int f = 0; f < numFormants; ++f)
+        {
+            currentSections[f].log2Frequency += sectionSteps[f].log2Frequency;
+            currentSections[f].k += sectionSteps[f].k;
+            currentSections[f].gain += sectionSteps[f].gain;
+        }
+    }
     
-    // Create bandpass filter coefficients
-    auto coefficients = juce::IIRCoefficients::makeBandPass(sampleRate, frequency, q);
+    applyCurrentCoefficients();
+}
+
+void VowelFilter::applyCurrentCoefficients()
+{
+    if (formantBank.getNumFormants() != maxFormants)
+        return; // Not prepared yet; prepareToPlay applies them
     
-    // Apply gain scaling
-    float safeGain = juce::jlimit(0.1f, 2.0f, gain);
+    for (int f = 0; f < numFormants; ++f)
+        formantBank.setFormant(f, coefficientTable->lookup(currentSections[f].log2Frequency),
+                               currentSections[f].k, currentSections[f].gain);
+}
+
+VowelFilter::SectionParameters VowelFilter::makeSectionParameters(float log2Frequency, float log2Bandwidth, float gain) const
+{
+    // The old limits in the log domain: frequency 50 Hz to 0.4 fs, bandwidth
+    // 20 Hz to half the frequency, Q = frequency / bandwidth from 0.7 to 8
+    constexpr float log2MinFrequency = 5.643856f;   // 50 Hz
+    constexpr float log2MinBandwidth = 4.321928f;   // 20 Hz
+    constexpr float log2MinQ = -0.514573f;          // 0.7
     
-    // Scale coefficients properly - only scale the numerator (b coefficients)
-    coefficients.coefficients[0] *= safeGain; // b0
-    coefficients.coefficients[1] *= safeGain; // b1  
-    coefficients.coefficients[2] *= safeGain; // b2
+    log2Frequency = juce::jlimit(log2MinFrequency, log2MaxFrequency, log2Frequency);
+    log2Bandwidth = juce::jlimit(log2MinBandwidth, log2Frequency - 1.0f, log2Bandwidth);
+    const float log2Q = juce::jlimit(log2MinQ, 3.0f, log2Frequency - log2Bandwidth);
     
-    filter->setCoefficients(coefficients);
-}
\ No newline at end of file
+    SectionParameters section;
+    section.log2Frequency = log2Frequency - log2SampleRate;
+    section.k = std::exp2(-log2Q);
+    section.gain = juce::jlimit(0.0f, 2.0f, gain);
+    return section;
+}
@@ -10,6 +10,9 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "FormantBank.h"
+#include "FormantCoefficientTable.h"
+#include "FormantLibrary.h"
 
 class VowelFilter
 {
@@ -28,12 +31,14 @@ public:
     ~VowelFilter();
 
     // Setup and processing
-    void prepareToPlay(double sampleRate, int samplesPerBlock);
+    void prepareToPlay(double sampleRate, int samplesPerBlock, int numChannels);
     void process(juce::AudioBuffer<float>& buffer);
     void reset();
 
     // Main controls
-    void setVowelType(VowelType vowel);
+    void setVowelType(VowelType vowel);                     // Jumps to that vowel's point in the vowel space
+    void setVowelPosition(juce::Point<float> position);     // Anywhere in the vowel space, see getVowelPosition()
+    void setFormantSet(const FormantSet* set);              // Voice type; must outlive the filter, as library sets do
     void setFundamentalFrequency(float frequency);
     
     // Additional filter controls
@@ -43,8 +48,25 @@ public:
     void setResonanceGain(float gainFactor);        // Overall formant intensity (0.1 - 2.0)
     void setHarmonicAlignment(bool enabled);        // Snap formants to harmonics
     
+    // Sets every control at once and rebuilds the coefficients at most once
+    void setParameters(juce::Point<float> vowelPosition, float shiftFactor, float spreadFactor,
+                       float bandwidthFactor, float gainFactor, bool alignToHarmonics);
+    
+    // The vowel space is laid out like the vowel quadrilateral: x runs front
+    // to back and y close to open, so I and U are the top corners, E and O sit
+    // halfway down and A is the open bottom edge. Each vowel of a formant set
+    // has its own point; positions in between blend the nearby vowels'
+    // formant frequencies and bandwidths geometrically, the gains linearly.
+    static juce::Point<float> getVowelPosition(VowelType vowel);
+    
+    // Ramp time for coefficient and gain changes; 0 switches instantly like the
+    // old code did. Takes effect on the next prepareToPlay().
+    void setSmoothingTime(double seconds) { smoothingTime = seconds; }
+    
     // Parameter getters
-    VowelType getVowelType() const { return currentVowel; }
+    VowelType getVowelType() const;   // Nearest cardinal vowel to the current position
+    const FormantSet& getFormantSet() const { return *formantSet; }
+    juce::Point<float> getVowelPosition() const { return vowelPosition; }
     float getFundamentalFrequency() const { return currentFundamental; }
     float getFormantShift() const { return formantShift; }
     float getFormantSpread() const { return formantSpread; }
@@ -53,30 +75,48 @@ public:
     bool getHarmonicAlignment() const { return harmonicAlignment; }
 
 private:
-    struct FormantData
+    static constexpr int maxFormants = FormantVowel::maxFormants;
+    
+    // Vowel data comes from the process-wide formant library
+    juce::SharedResourcePointer<FormantLibraryCache> formantLibrary;
+    const FormantSet* formantSet = nullptr;
+    int numFormants = 0;
+    
+    // Coefficients are only recomputed once per parameter change, then
+    // interpolated towards in steps of this many samples
+    static constexpr int coefficientSubBlock = 32;
+    
+    // All formants of a channel run side by side in SIMD lanes
+    FormantBank formantBank;
+    
+    // Shared by every VowelFilter; built once when the first one is created
+    juce::SharedResourcePointer<FormantCoefficientTable> coefficientTable;
+    
+    // What a formant section is tuned to; these ramp, not filter coefficients
+    struct SectionParameters
     {
-        float f1, f2, f3;           // Formant frequencies (Hz)
-        float bw1, bw2, bw3;        // Bandwidths (Hz)
-        float gain1, gain2, gain3;  // Gains (linear)
+        float log2Frequency = -4.0f;    // log2 (frequency / sample rate)
+        float k = 0.1f;                 // 1 / Q
+        float gain = 1.0f;
     };
-
-    // Formant data for each vowel
-    static const FormantData vowelFormants[NumVowels];
-
-    // Filter bank - 3 formants per channel
-    std::vector<std::unique_ptr<juce::IIRFilter>> formant1Filters;
-    std::vector<std::unique_ptr<juce::IIRFilter>> formant2Filters;
-    std::vector<std::unique_ptr<juce::IIRFilter>> formant3Filters;
-
-    // Processing buffers
-    juce::AudioBuffer<float> tempBuffer;
+    
+    // Section ramp, shared by every channel
+    SectionParameters currentSections[maxFormants];
+    SectionParameters targetSections[maxFormants];
+    SectionParameters sectionSteps[maxFormants];
+    int rampSubBlocks = 0;
+    int rampSubBlocksRemaining = 0;
+    bool coefficientsInitialised = false;
+    
+    juce::SmoothedValue<float> resonanceGainSmoother { 1.0f };
+    double smoothingTime = 0.02;
 
     // Audio parameters
     double sampleRate;
     int numChannels;
 
     // Core vowel parameters
-    VowelType currentVowel;
+    juce::Point<float> vowelPosition;
     float currentFundamental;
     float referenceFundamental;     // Reference pitch for scaling (220Hz)
 
@@ -86,10 +126,29 @@ private:
     float bandwidthScale;           // Bandwidth scaling factor
     float resonanceGain;            // Overall formant gain
     bool harmonicAlignment;         // Snap formants to harmonics
+    
+    // The adjustments are all multiplicative, so they are kept as log2 terms
+    // and a retune only adds them up. Refreshed when the parameter changes,
+    // except the pitch term, which is the one that moves every block.
+    float log2SampleRate = 0.0f;
+    float log2MaxFrequency = 0.0f;
+    float log2PitchScale = 0.0f;    // log2 (fundamental / reference) / 4
+    float log2Shift = 0.0f;
+    float log2BandwidthScale = 0.0f;
+    float log2Spread[maxFormants] = {};
+    
+    // The formants at vowelPosition, morphed from the vowel table
+    float log2VowelFrequency[maxFormants] = {};
+    float log2VowelBandwidth[maxFormants] = {};
+    float vowelGain[maxFormants] = {};
 
     // Internal methods
     void updateFilters();
-    void createBandpassFilter(juce::IIRFilter* filter, float frequency, float bandwidth, float gain);
+    void updateLog2Terms();
+    void updateVowelMorph();
+    SectionParameters makeSectionParameters(float log2Frequency, float log2Bandwidth, float gain) const;
+    void advanceCoefficientRamp();
+    void applyCurrentCoefficients();
     float findNearestHarmonic(float formantFreq, float fundamental);
-    float applyFormantAdjustments(float baseFrequency, int formantIndex);
+    float applyFormantAdjustments(float log2BaseFrequency, int formantIndex);
 };
\ No newline at end of file
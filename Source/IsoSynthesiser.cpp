@@ -0,0 +1,265 @@
+/*
+  ==============================================================================
+
+    IsoSynthesiser.cpp
+    Created: 17 Oct 2026 10:12:03am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "IsoSynthesiser.h"
+#include "IsoSound.h"
+
+IsoSynthesiser::IsoSynthesiser()
+{
+    addSound(new IsoSound());
+    setNoteStealingEnabled(true);
+    rebuildVoicePool();
+    renderJobs.ensureStorageAllocated(maxVoices);
+}
+
+void IsoSynthesiser::setVoiceCount(int numVoices)
+{
+    requestedVoices = juce::jlimit(minVoices, maxVoices, numVoices);
+}
+
+void IsoSynthesiser::rebuildVoicePool()
+{
+    if (getNumVoices() == requestedVoices)
+        return;
+
+    while (getNumVoices() > requestedVoices)
+        removeVoice(getNumVoices() - 1);
+
+    while (getNumVoices() < requestedVoices)
+        static_cast<IsoVoice*>(addVoice(new IsoVoice()))->setNoteExpressionSource(&nextNoteExpression);
+}
+
+void IsoSynthesiser::prepare(double sampleRate, int samplesPerBlock, int numChannels, MidiProcessor* midiProcessor)
+{
+    // All allocation happens here: the pool is resized and every voice sizes
+    // its buffers and filter banks for the largest block the host will send
+    rebuildVoicePool();
+
+    // Voices only ever see the oversampled rate
+    const double voiceSampleRate = sampleRate * oversamplingFactor;
+    const int voiceBlockSize = samplesPerBlock * oversamplingFactor;
+    setCurrentPlaybackSampleRate(voiceSampleRate);
+
+    for (int i = 0; i < getNumVoices(); ++i)
+    {
+        auto* voice = getIsoVoice(i);
+        voice->setMidiProcessor(midiProcessor);
+        voice->setParameterSnapshot(parameters);
+        
+        if (hasNoiseSeed)
+            voice->setNoiseSeed(noiseSeed + i);
+        
+        voice->prepareToPlay(voiceSampleRate, voiceBlockSize, numChannels);
+    }
+
+    oversampledBus.setSize(numChannels, oversamplingFactor > 1 ? voiceBlockSize : 0);
+    decimator.prepare(oversamplingFactor, numChannels, samplesPerBlock);
+}
+
+void IsoSynthesiser::resetVoices()
+{
+    for (int i = 0; i < getNumVoices(); ++i)
+        getIsoVoice(i)->reset_filter();
+
+    decimator.reset();
+}
+
+void IsoSynthesiser::setOversamplingFactor(int factor)
+{
+    oversamplingFactor = juce::jlimit(1, HalfBandDecimator::maxFactor, juce::nextPowerOfTwo(juce::jmax(1, factor)));
+}
+
+void IsoSynthesiser::setParameterSnapshot(const ParameterSnapshot* snapshot)
+{
+    parameters = snapshot;
+
+    for (int i = 0; i < getNumVoices(); ++i)
+        getIsoVoice(i)->setParameterSnapshot(parameters);
+}
+
+void IsoSynthesiser::setRenderThreads(int numThreads)
+{
+    const int workers = juce::jlimit(0, juce::SystemStats::getNumCpus() - 1, numThreads - 1);
+
+    if (workers == getRenderThreads() - 1)
+        return;
+
+    renderPool.reset();
+
+    if (workers > 0)
+        renderPool = std::make_unique<RenderThreadPool>(workers);
+}
+
+void IsoSynthesiser::renderVoices(juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+{
+    if (oversamplingFactor == 1)
+    {
+        renderVoicesAtVoiceRate(outputAudio, startSample, numSamples);
+        return;
+    }
+
+    // Sub-blocks between MIDI events are rendered and decimated one at a
+    // time, so note timing keeps its host rate resolution
+    const int numVoiceSamples = numSamples * oversamplingFactor;
+    oversampledBus.clear(0, numVoiceSamples);
+    renderVoicesAtVoiceRate(oversampledBus, 0, numVoiceSamples);
+    decimator.process(oversampledBus, outputAudio, startSample, numSamples);
+}
+
+void IsoSynthesiser::renderVoicesAtVoiceRate(juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+{
+    if (renderPool == nullptr)
+    {
+        juce::Synthesiser::renderVoices(outputAudio, startSample, numSamples);
+        return;
+    }
+
+    renderJobs.clearQuick();
+
+    for (int i = 0; i < getNumVoices(); ++i)
+    {
+        auto* voice = getIsoVoice(i);
+
+        if (voice->needsRendering())
+            renderJobs.add(voice);
+    }
+
+    renderJobSamples = numSamples;
+    renderPool->run(*this, renderJobs.size());
+
+    // Summing stays on this thread and in a fixed order so the float additions
+    // happen exactly as they do in the single threaded path
+    for (int i = 0; i < getNumVoices(); ++i)
+        getIsoVoice(i)->mixVoiceBlock(outputAudio, startSample, numSamples);
+}
+
+void IsoSynthesiser::perform(int taskIndex) noexcept
+{
+    renderJobs.getUnchecked(taskIndex)->renderVoiceBlock(renderJobSamples);
+}
+
+void IsoSynthesiser::handleMidiEvent(const juce::MidiMessage& message)
+{
+    zoneLayout.processNextMidiEvent(message);
+    juce::Synthesiser::handleMidiEvent(message);
+}
+
+void IsoSynthesiser::noteOn(int midiChannel, int midiNoteNumber, float velocity)
+{
+    // One note starts at a time, so a single slot is enough
+    nextNoteExpression = getNoteExpression(midiChannel);
+    juce::Synthesiser::noteOn(midiChannel, midiNoteNumber, velocity);
+}
+
+void IsoSynthesiser::handlePitchWheel(int midiChannel, int wheelValue)
+{
+    if (midiChannel < 1 || midiChannel > 16)
+        return;
+    
+    channelExpression[static_cast<size_t>(midiChannel)].pitchWheel = wheelValue;
+    
+    // A master channel has no notes of its own but bends its whole zone
+    for (const auto& zone : { zoneLayout.getLowerZone(), zoneLayout.getUpperZone() })
+        if (zone.isActive() && zone.getMasterChannel() == midiChannel)
+            for (int i = 0; i < getNumVoices(); ++i)
+                getIsoVoice(i)->masterPitchWheelMoved(midiChannel, wheelValue);
+    
+    juce::Synthesiser::handlePitchWheel(midiChannel, wheelValue);
+}
+
+void IsoSynthesiser::handleController(int midiChannel, int controllerNumber, int controllerValue)
+{
+    if (controllerNumber == 74 && midiChannel >= 1 && midiChannel <= 16)
+        channelExpression[static_cast<size_t>(midiChannel)].timbre = controllerValue / 127.0f;
+    
+    juce::Synthesiser::handleController(midiChannel, controllerNumber, controllerValue);
+}
+
+void IsoSynthesiser::handleChannelPressure(int midiChannel, int channelPressureValue)
+{
+    if (midiChannel >= 1 && midiChannel <= 16)
+        channelExpression[static_cast<size_t>(midiChannel)].pressure = channelPressureValue / 127.0f;
+    
+    juce::Synthesiser::handleChannelPressure(midiChannel, channelPressureValue);
+}
+
+IsoVoice::NoteExpression IsoSynthesiser::getNoteExpression(int midiChannel) const
+{
+    IsoVoice::NoteExpression expression;
+    
+    if (midiChannel < 1 || midiChannel > 16)
+        return expression;
+    
+    const auto& channel = channelExpression[static_cast<size_t>(midiChannel)];
+    expression.pressure = channel.pressure;
+    expression.timbre = channel.timbre;
+    
+    for (const auto& zone : { zoneLayout.getLowerZone(), zoneLayout.getUpperZone() })
+    {
+        if (zone.isActive() && zone.isUsingChannelAsMemberChannel(midiChannel))
+        {
+            expression.pitchBendRange = static_cast<float>(zone.perNotePitchbendRange);
+            expression.masterChannel = zone.getMasterChannel();
+            expression.masterPitchBendRange = static_cast<float>(zone.masterPitchbendRange);
+            expression.masterPitchWheel = channelExpression[static_cast<size_t>(expression.masterChannel)].pitchWheel;
+        }
+    }
+    
+    return expression;
+}
+
+int IsoSynthesiser::getNumActiveVoices() const
+{
+    int active = 0;
+
+    for (auto* voice : voices)
+        if (voice->isVoiceActive())
+            ++active;
+
+    return active;
+}
+
+juce::SynthesiserVoice* IsoSynthesiser::findVoiceToSteal(juce::SynthesiserSound* soundToPlay,
+                                                         int midiChannel, int midiNoteNumber) const
+{
+    IsoVoice* quietestReleased = nullptr;
+    IsoVoice* quietestHeld = nullptr;
+
+    for (auto* v : voices)
+    {
+        auto* voice = static_cast<IsoVoice*>(v);
+
+        if (! voice->canPlaySound(soundToPlay))
+            continue;
+
+        // Retriggering a note that is already sounding reuses its voice
+        if (voice->isPlayingChannel(midiChannel) && voice->getCurrentlyPlayingNote() == midiNoteNumber)
+            return voice;
+
+        if (voice->isPlayingButReleased())
+        {
+            if (quietestReleased == nullptr || voice->getCurrentLevel() < quietestReleased->getCurrentLevel())
+                quietestReleased = voice;
+        }
+        else if (quietestHeld == nullptr || voice->getCurrentLevel() < quietestHeld->getCurrentLevel())
+        {
+            quietestHeld = voice;
+        }
+    }
+
+    // Released drones are already on their way out, so they go first
+    auto* stolen = quietestReleased != nullptr ? quietestReleased : quietestHeld;
+
+    if (logger != nullptr && stolen != nullptr)
+        logger->log(RealtimeLogger::Severity::info, RealtimeLogger::voiceCategory,
+                    RealtimeLogger::Event::voiceStolen, 0, midiNoteNumber, midiChannel);
+
+    return stolen;
+}
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    IsoSynthesiser.h
+    Created: 17 Oct 2026 10:12:03am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "IsoVoice.h"
+#include "Data/HalfBandDecimator.h"
+#include "Utility/RealtimeLogger.h"
+#include "Utility/RenderThreadPool.h"
+
+class MidiProcessor;
+
+// Synthesiser with a fixed, preallocated pool of IsoVoices and a voice
+// stealing policy tuned for long, overlapping drones. Active voices can be
+// rendered in parallel on a RenderThreadPool; they are always summed in voice
+// order, so the output does not depend on the number of threads.
+//
+// MPE: once an MPE configuration message sets up a zone, every note on a
+// member channel has that channel's bend, pressure and CC74 timbre to
+// itself, and the zone's master channel bends all of them. Without a zone
+// the same messages act per channel as usual.
+//
+// Oversampling: at 2x and up every voice runs at that multiple of the host
+// rate, source, formant bank and clipper included, into one shared bus that
+// a single decimator per output channel brings back down. The decimation
+// cost doesn't grow with the number of voices.
+class IsoSynthesiser : public juce::Synthesiser,
+                       private RenderThreadPool::Job
+{
+public:
+    static constexpr int minVoices = 8;
+    static constexpr int maxVoices = 256;
+    static constexpr int defaultVoices = 32;
+
+    IsoSynthesiser();
+
+    // Voice pool management - never call these from the audio thread
+    void setVoiceCount(int numVoices);
+    int getVoiceCount() const { return requestedVoices; }
+    void prepare(double sampleRate, int samplesPerBlock, int numChannels, MidiProcessor* midiProcessor);
+    void resetVoices();
+    void setParameterSnapshot(const ParameterSnapshot* snapshot);
+    void setLogger(RealtimeLogger* loggerPtr) { logger = loggerPtr; }
+
+    // Voice i's breath noise starts from seed + i, so renders repeat exactly;
+    // applied by the next prepare(). Without one each voice is seeded randomly.
+    void setNoiseSeed(juce::int64 seed) { noiseSeed = seed; hasNoiseSeed = true; }
+    
+    // 1 renders on the audio thread only; more adds numThreads - 1 workers
+    void setRenderThreads(int numThreads);
+    int getRenderThreads() const { return renderPool != nullptr ? renderPool->getNumParticipants() : 1; }
+
+    // 1, 2, 4 or 8, applied by the next prepare()
+    void setOversamplingFactor(int factor);
+    int getOversamplingFactor() const { return oversamplingFactor; }
+
+    // Delay the decimator adds, in samples at the host rate
+    double getLatency() const { return decimator.getLatency(); }
+
+    IsoVoice* getIsoVoice(int index) const { return static_cast<IsoVoice*>(getVoice(index)); }
+    int getNumActiveVoices() const;
+    
+    void noteOn(int midiChannel, int midiNoteNumber, float velocity) override;
+    void handlePitchWheel(int midiChannel, int wheelValue) override;
+    void handleController(int midiChannel, int controllerNumber, int controllerValue) override;
+    void handleChannelPressure(int midiChannel, int channelPressureValue) override;
+
+protected:
+    // Prefers a voice already holding the note, then the quietest released
+    // voice, then the quietest voice overall
+    juce::SynthesiserVoice* findVoiceToSteal(juce::SynthesiserSound* soundToPlay,
+                                             int midiChannel, int midiNoteNumber) const override;
+
+    using juce::Synthesiser::renderVoices;
+    void renderVoices(juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples) override;
+    
+    // Feeds MPE configuration messages to the zone layout first
+    void handleMidiEvent(const juce::MidiMessage& message) override;
+
+private:
+    void rebuildVoicePool();
+    void renderVoicesAtVoiceRate(juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples);
+    void perform(int taskIndex) noexcept override;
+    IsoVoice::NoteExpression getNoteExpression(int midiChannel) const;
+
+    int requestedVoices = defaultVoices;
+    const ParameterSnapshot* parameters = nullptr;
+    RealtimeLogger* logger = nullptr;
+
+    // Latest expression per MIDI channel (index 1-16), for notes yet to start
+    struct ChannelExpression
+    {
+        int pitchWheel = 8192;
+        float pressure = 0.0f;
+        float timbre = 0.5f;
+    };
+    
+    juce::MPEZoneLayout zoneLayout;
+    std::array<ChannelExpression, 17> channelExpression;
+    IsoVoice::NoteExpression nextNoteExpression;    // Read by the voice noteOn() starts
+    
+    std::unique_ptr<RenderThreadPool> renderPool;
+    juce::Array<IsoVoice*> renderJobs;
+    int renderJobSamples = 0;
+
+    juce::int64 noiseSeed = 0;
+    bool hasNoiseSeed = false;
+    
+    int oversamplingFactor = 1;
+    juce::AudioBuffer<float> oversampledBus;
+    HalfBandDecimator decimator;
+};
@@ -18,26 +18,43 @@ bool IsoVoice::canPlaySound (juce::SynthesiserSound* sound)
 
 void IsoVoice::startNote (int midiNoteNumber, float velocity, juce::SynthesiserSound *sound, int currentPitchWheelPosition)
 {
-    // Store current MIDI note for vowel filter pitch tracking
+    // The tuned pitch comes straight from the tuning table; keys the
+    // keyboard mapping leaves out don't sound
+    noteFrequency = static_cast<float> (midiProcessor != nullptr ? midiProcessor->midiNoteToFrequency (midiNoteNumber)
+                                                                 : juce::MidiMessage::getMidiNoteInHertz (midiNoteNumber));
+    
+    if (noteFrequency <= 0.0f)
+    {
+        clearCurrentNote();
+        currentMidiNote = -1;
+        return;
+    }
+    
     currentMidiNote = midiNoteNumber;
+    fadeInSamplesRemaining = 0;
     
-    // Convert MIDI note number to frequency using JUCE's built-in function
-    float frequency = juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber);
+    const auto previous = expression;
+    expression = noteExpressionSource != nullptr ? *noteExpressionSource : NoteExpression();
+    pitchWheel = currentPitchWheelPosition;
+    updatePitch();
     
-    // Set the oscillator frequency to the note's frequency
-    osc.setWaveFrequency(frequency);
+    // Stack the twelve pitch classes around the circle of fifths so close
+    // intervals land far apart in the stereo field
+    notePanPosition = static_cast<float> ((midiNoteNumber * 7) % 12) / 5.5f - 1.0f;
     
-    // Update vowel filter with current pitch if MidiProcessor is available
-    if (midiProcessor && currentMidiNote >= 0)
-    {
-        float accurateFrequency = midiProcessor->midiNoteToFrequency(currentMidiNote);
-        filterData.setFundamentalFrequency(accurateFrequency);
-    }
-    else
-    {
-        // Fallback to standard 12-TET frequency
-        filterData.setFundamentalFrequency(frequency);
-    }
+    // Pick up parameter changes made while this voice was idle, then this
+    // note's own pressure and timbre if they differ from the last note's
+    applyParameterSnapshot();
+    
+    if (expression.pressure != previous.pressure)
+        updateGlottalSource();
+    
+    if (expression.timbre != previous.timbre)
+        updateFormantShift();
+    
+    // A new note starts at its own position; only spread changes glide
+    updatePanTarget();
+    panGains = targetPanGains;
     
     // Trigger the ADSR envelope
     adsr.noteOn();
@@ -45,9 +62,20 @@ void IsoVoice::startNote (int midiNoteNumber, float velocity, juce::SynthesiserS
 
 void IsoVoice::stopNote (float velocity, bool allowTailOff)
 {
+    // A hard stop on a sounding voice means it is being stolen: keep a short
+    // faded tail of the old note so the cut doesn't click
+    if (! allowTailOff && isVoiceActive())
+        beginFadeOut();
+
     adsr.noteOff();
     if (! allowTailOff || ! adsr.isActive())
     {
+        if (! allowTailOff)
+        {
+            adsr.reset();
+            filterData.reset();
+        }
+
         clearCurrentNote();
         currentMidiNote = -1; // Clear current note
     }
@@ -55,40 +83,112 @@ void IsoVoice::stopNote (float velocity, bool allowTailOff)
 
 void IsoVoice::controllerMoved (int controllerNumber, int newControllerValue)
 {
+    // CC74 is MPE's timbre dimension (brightness on ordinary controllers)
+    if (controllerNumber != 74 || currentMidiNote < 0)
+        return;
+    
+    expression.timbre = newControllerValue / 127.0f;
+    updateFormantShift();
+}
+
+void IsoVoice::channelPressureChanged (int newChannelPressureValue)
+{
+    if (currentMidiNote < 0)
+        return;
+    
+    expression.pressure = newChannelPressureValue / 127.0f;
+    updateGlottalSource();
+}
+
+void IsoVoice::aftertouchChanged (int newAftertouchValue)
+{
+    // Polyphonic aftertouch is per note already, so it drives the same thing
+    channelPressureChanged (newAftertouchValue);
 }
 
 void IsoVoice::pitchWheelMoved (int newPitchWheelValue)
 {
-    float pitchBend = (newPitchWheelValue - 8192) / 8192.0f;
+    if (currentMidiNote < 0)
+        return;
     
-    // Update vowel filter frequency when pitch wheel moves
-    if (midiProcessor && currentMidiNote >= 0)
-    {
-        // Calculate bent frequency - assuming ±2 semitone range
-        float basePitch = midiProcessor->midiNoteToFrequency(currentMidiNote);
-        float bentFrequency = basePitch * std::pow(2.0f, pitchBend * (2.0f / 12.0f)); // ±2 semitones
-        filterData.setFundamentalFrequency(bentFrequency);
-    }
+    pitchWheel = newPitchWheelValue;
+    updatePitch();
+}
+
+void IsoVoice::masterPitchWheelMoved (int masterChannel, int newPitchWheelValue)
+{
+    if (currentMidiNote < 0 || masterChannel != expression.masterChannel)
+        return;
+    
+    expression.masterPitchWheel = newPitchWheelValue;
+    updatePitch();
+}
+
+void IsoVoice::updatePitch()
+{
+    // The note's own bend and its zone's bend add up
+    const float semitones = (pitchWheel - 8192) / 8192.0f * expression.pitchBendRange
+                          + (expression.masterPitchWheel - 8192) / 8192.0f * expression.masterPitchBendRange;
+    const float frequency = noteFrequency * std::exp2 (semitones / 12.0f);
     
-    // You could implement additional pitch bend logic here if needed
+    osc.setWaveFrequency (frequency);
+    filterData.setFundamentalFrequency (frequency);
+}
+
+void IsoVoice::updateGlottalSource()
+{
+    if (parameters == nullptr)
+        return;
+    
+    // Pressure blows the source open: full pressure is all breath
+    const float breathiness = parameters->breathiness + expression.pressure * (1.0f - parameters->breathiness);
+    setGlottalParams (parameters->openQuotient, parameters->asymmetry, breathiness, parameters->tenseness);
+}
+
+void IsoVoice::updateFormantShift()
+{
+    // Timbre moves the formants up to half an octave either way
+    if (parameters != nullptr)
+        filterData.setFormantShift (parameters->formantShift * getTimbreShift());
 }
 
 void IsoVoice::prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels)
 {
     adsr.setSampleRate (sampleRate);
     
+    // Steal and program switch fades of ~5ms are rendered in one go, so
+    // everything in renderVoice must take a whole fade even when host blocks are shorter
+    const int fadeLength = juce::roundToInt (sampleRate * 0.005);
+    const int maxRenderLength = juce::jmax (samplesPerBlock, fadeLength);
+    
+    // Everything up to the pan stage runs on a single channel; the output
+    // channel count only matters when mixing
     juce::dsp::ProcessSpec spec;
-    spec.maximumBlockSize = samplesPerBlock;
+    spec.maximumBlockSize = static_cast<juce::uint32> (maxRenderLength);
     spec.sampleRate = sampleRate;
-    spec.numChannels = outputChannels;
+    spec.numChannels = 1;
     
     // Use OscData's prepareToPlay method
     osc.prepareToPlay(spec);
     gain.prepare (spec);
     gain.setGainLinear (1.0f);
     
+    fadeBuffer.setSize (1, fadeLength);
+    fadeSamplesRemaining = 0;
+    fadeReadPosition = 0;
+    fadeInSamplesRemaining = 0;
+    
     // Prepare vowel filter
-    filterData.prepareToPlay(sampleRate, samplesPerBlock);
+    filterData.prepareToPlay(sampleRate, maxRenderLength, 1);
+    
+    // Preallocate the voice buffer so rendering never has to grow it
+    isoBuffer.setSize (1, samplesPerBlock);
+    currentLevel = 0.0f;
+    
+    // The pan stage knows mono and stereo, the only layouts the processor accepts
+    jassert (outputChannels <= 2);
+    juce::ignoreUnused (outputChannels);
+    panGains = targetPanGains = fadePanGains = { 1.0f, 1.0f };
     
     isPrepared = true;
 }
@@ -104,17 +204,108 @@ void IsoVoice::reset_filter()
 }
 
 void IsoVoice::renderNextBlock (juce::AudioBuffer< float > &outputBuffer, int startSample, int numSamples)
+{
+    // Same two steps the parallel renderer runs on separate threads, so both
+    // paths produce bit-identical output
+    renderVoiceBlock (numSamples);
+    mixVoiceBlock (outputBuffer, startSample, numSamples);
+}
+
+void IsoVoice::renderVoiceBlock (int numSamples)
 {
     jassert (isPrepared);
+    renderedSamples = 0;
+    
     if (! isVoiceActive())
+    {
+        currentLevel = 0.0f;
         return;
+    }
     
-    // Set up temporary buffer for this voice
-    isoBuffer.setSize (outputBuffer.getNumChannels(), numSamples, false, false, true);
-    isoBuffer.clear();
+    // A program switch changes the wave type and envelope in one go, so the
+    // old program's sound fades out over a few ms while the new one fades in.
+    // A tail still fading keeps its buffer; the switch then just glides.
+    if (parameters != nullptr && parameters->generation == appliedGeneration + 1
+        && (parameters->dirty & ParameterSnapshot::programDirty) != 0 && fadeSamplesRemaining == 0)
+    {
+        beginFadeOut();
+        fadeInSamplesRemaining = fadeBuffer.getNumSamples();
+    }
+    
+    applyParameterSnapshot();
+    
+    // Set up temporary buffer for this voice (capacity reserved in prepareToPlay)
+    isoBuffer.setSize (isoBuffer.getNumChannels(), numSamples, false, false, true);
+    renderVoice (isoBuffer, numSamples);
+    
+    if (fadeInSamplesRemaining > 0)
+    {
+        const int fadeLength = fadeBuffer.getNumSamples();
+        const int numFadeSamples = juce::jmin (numSamples, fadeInSamplesRemaining);
+        const int position = fadeLength - fadeInSamplesRemaining;
+        
+        isoBuffer.applyGainRamp (0, numFadeSamples, static_cast<float> (position) / fadeLength,
+                                 static_cast<float> (position + numFadeSamples) / fadeLength);
+        fadeInSamplesRemaining -= numFadeSamples;
+    }
+    
+    currentLevel = isoBuffer.getMagnitude (0, numSamples);
+    renderedSamples = numSamples;
+    
+    // Check if voice should be stopped
+    if (!adsr.isActive())
+        clearCurrentNote();
+}
+
+void IsoVoice::mixVoiceBlock (juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    const int numChannels = juce::jmin (outputBuffer.getNumChannels(), 2);
+    const bool stereo = numChannels == 2;
+    
+    // Mix in what is left of a stolen note's tail, even if the voice is now idle
+    if (fadeSamplesRemaining > 0)
+    {
+        const int numFadeSamples = juce::jmin (numSamples, fadeSamplesRemaining);
+        const auto* fade = fadeBuffer.getReadPointer (0, fadeReadPosition);
+        
+        for (int channel = 0; channel < numChannels; ++channel)
+            outputBuffer.addFrom (channel, startSample, fade, numFadeSamples, stereo ? fadePanGains[(size_t) channel] : 1.0f);
+        
+        fadeReadPosition += numFadeSamples;
+        fadeSamplesRemaining -= numFadeSamples;
+    }
+    
+    if (renderedSamples == 0)
+        return;
+    
+    jassert (renderedSamples == numSamples);
+    
+    // Pan stage: the mono voice goes to both sides, ramping over one block
+    // whenever the spread moved
+    const auto* voice = isoBuffer.getReadPointer (0);
+    
+    if (stereo)
+    {
+        for (int channel = 0; channel < 2; ++channel)
+            outputBuffer.addFromWithRamp (channel, startSample, voice, numSamples,
+                                          panGains[(size_t) channel], targetPanGains[(size_t) channel]);
+        
+        panGains = targetPanGains;
+    }
+    else if (numChannels == 1)
+    {
+        outputBuffer.addFrom (0, startSample, voice, numSamples);
+    }
+    
+    renderedSamples = 0;
+}
+
+void IsoVoice::renderVoice (juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    buffer.clear();
     
     // Get audio block from buffer - this is the TAP pattern
-    juce::dsp::AudioBlock<float> audioBlock { isoBuffer };
+    juce::dsp::AudioBlock<float> audioBlock { buffer };
     
     // Process the oscillator - this calls your OscData::getNextAudioBlock
     osc.getNextAudioBlock (audioBlock);
@@ -122,28 +313,80 @@ void IsoVoice::renderNextBlock (juce::AudioBuffer< float > &outputBuffer, int st
     // Apply gain processing
     gain.process (juce::dsp::ProcessContextReplacing<float> (audioBlock));
     
-    // Update vowel filter frequency in real-time (in case MidiProcessor results changed)
-    if (midiProcessor && currentMidiNote >= 0)
-    {
-        float currentFrequency = midiProcessor->midiNoteToFrequency(currentMidiNote);
-        filterData.setFundamentalFrequency(currentFrequency);
-    }
-    
     // Apply the vowel filter
-    filterData.process(isoBuffer);
+    filterData.process(buffer);
     
     // Apply ADSR envelope to the processed buffer
-    adsr.applyEnvelopeToBuffer(isoBuffer, 0, numSamples);
+    adsr.applyEnvelopeToBuffer(buffer, 0, numSamples);
+}
+
+void IsoVoice::beginFadeOut()
+{
+    const int fadeLength = fadeBuffer.getNumSamples();
+    
+    if (fadeLength == 0)
+        return;
+    
+    // Render the next few ms of the old note ahead of time, then ramp it out
+    renderVoice (fadeBuffer, fadeLength);
+    fadeBuffer.applyGainRamp (0, fadeLength, 1.0f, 0.0f);
+    fadePanGains = panGains;
+    
+    fadeSamplesRemaining = fadeLength;
+    fadeReadPosition = 0;
+}
+
+void IsoVoice::applyParameterSnapshot()
+{
+    if (parameters == nullptr || parameters->generation == appliedGeneration)
+        return;
+    
+    // Dirty bits only describe the step from the previous generation
+    const auto dirty = parameters->generation == appliedGeneration + 1 ? parameters->dirty
+                                                                       : juce::uint32 (ParameterSnapshot::allDirty);
+    appliedGeneration = parameters->generation;
+    
+    if (dirty & ParameterSnapshot::oscillatorDirty)
+        osc.setWaveType (parameters->oscWaveType);
+    
+    if (dirty & ParameterSnapshot::glottalDirty)
+        updateGlottalSource();
+    
+    if (dirty & ParameterSnapshot::envelopeDirty)
+        update (parameters->attack, parameters->decay, parameters->sustain, parameters->release);
     
-    // Add the voice's output to the main output buffer
-    for (int channel = 0; channel < outputBuffer.getNumChannels(); ++channel)
+    if (dirty & ParameterSnapshot::formantDirty)
     {
-        outputBuffer.addFrom(channel, startSample, isoBuffer, channel, 0, numSamples);
+        filterData.setFormantSet (parameters->formantSet);
+        filterData.setParameters (parameters->vowelPosition, parameters->formantShift * getTimbreShift(), parameters->formantSpread,
+                                  parameters->bandwidthScale, parameters->resonanceGain, parameters->harmonicAlignment);
     }
+    else if (dirty & ParameterSnapshot::resonanceDirty)
+        filterData.setResonanceGain (parameters->resonanceGain);
     
-    // Check if voice should be stopped
-    if (!adsr.isActive())
-        clearCurrentNote();
+    if (dirty & ParameterSnapshot::stereoDirty)
+    {
+        stereoSpread = parameters->stereoSpread;
+        updatePanTarget();
+    }
+}
+
+void IsoVoice::updatePanTarget()
+{
+    // Constant power, normalised so a centred voice plays at unity on both
+    // sides - the same level the old per-channel copies had
+    const float pan = juce::jlimit (-1.0f, 1.0f, stereoSpread * notePanPosition);
+    
+    if (pan == 0.0f)
+    {
+        targetPanGains = { 1.0f, 1.0f };
+        return;
+    }
+    
+    const float angle = (pan + 1.0f) * juce::MathConstants<float>::pi * 0.25f;
+    
+    targetPanGains = { juce::MathConstants<float>::sqrt2 * std::cos (angle),
+                       juce::MathConstants<float>::sqrt2 * std::sin (angle) };
 }
 
 // Glottal parameter control (delegates to OscData)
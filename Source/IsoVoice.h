@@ -9,6 +9,7 @@
 #include "Data/ADSRData.h"
 #include "Data/OscData.h"
 #include "Data/VowelFilter.h"
+#include "ParameterSnapshot.h"
 
 // Forward declaration
 class MidiProcessor;
@@ -16,11 +17,32 @@ class MidiProcessor;
 class IsoVoice : public juce::SynthesiserVoice
 {
 public:
+    // Bend range of plain, non-MPE channels in semitones
+    static constexpr float defaultPitchBendRange = 2.0f;
+    
+    // What a new note inherits from its channel, filled in by IsoSynthesiser
+    // just before the note starts. MPE controllers send a note's initial
+    // pressure and timbre ahead of its note-on, so they come from here too.
+    struct NoteExpression
+    {
+        float pitchBendRange = defaultPitchBendRange;           // Semitones at full bend
+        int masterChannel = 0;                                  // MPE zone master, 0 if none
+        float masterPitchBendRange = defaultPitchBendRange;
+        int masterPitchWheel = 8192;
+        float pressure = 0.0f;                                  // 0..1
+        float timbre = 0.5f;                                    // 0..1, 0.5 is neutral
+    };
+    
     bool canPlaySound(juce::SynthesiserSound* sound) override;
     void startNote(int midiNoteNumber, float velocity, juce::SynthesiserSound *sound, int currentPitchWheelPosition) override;
     void stopNote(float velocity, bool allowTailOff) override;
     void controllerMoved(int controllerNumber, int newControllerValue) override;
     void pitchWheelMoved(int newPitchWheelValue) override;
+    void channelPressureChanged(int newChannelPressureValue) override;
+    void aftertouchChanged(int newAftertouchValue) override;
+    
+    // Zone-wide bend from an MPE master channel; ignored by voices outside the zone
+    void masterPitchWheelMoved(int masterChannel, int newPitchWheelValue);
     void prepareToPlay(double sampleRate, int samplesPerBlock, int outputChannels);
     void renderNextBlock(juce::AudioBuffer<float> &outputBuffer, int startSample, int numSamples) override;
 
@@ -32,27 +54,74 @@ public:
 
     // Glottal parameter control (delegates to OscData)
     void setGlottalParams(float oq, float alpha, float breath, float tension);
+    void setNoiseSeed(juce::int64 seed) { osc.setNoiseSeed(seed); }
     
     // VowelFilter control
     void setVowelType(VowelFilter::VowelType vowel) { filterData.setVowelType(vowel); }
     VowelFilter::VowelType getVowelType() const { return filterData.getVowelType(); }
     VowelFilter& getVowelFilter() { return filterData; }
     
-    // MidiProcessor integration for pitch-aware filtering
+    // Source of the tuned note frequencies
     void setMidiProcessor(MidiProcessor* processor) { midiProcessor = processor; }
     
+    // Read on every note start; nullptr starts notes with default expression
+    void setNoteExpressionSource(const NoteExpression* source) { noteExpressionSource = source; }
+    
+    // Per-block parameters shared by all voices; applied lazily when rendering
+    void setParameterSnapshot(const ParameterSnapshot* snapshot) { parameters = snapshot; appliedGeneration = 0; }
+    
     void reset_filter();
 
+    // Peak output level of the last rendered block, used for voice stealing
+    float getCurrentLevel() const { return currentLevel; }
+    
+    // Split rendering for IsoSynthesiser's parallel mode: renderVoiceBlock() only
+    // touches this voice and may run on any thread; mixVoiceBlock() adds the
+    // result to the shared output and runs in voice order on the audio thread
+    bool needsRendering() const { return isVoiceActive(); }
+    void renderVoiceBlock (int numSamples);
+    void mixVoiceBlock (juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples);
+
 private:
+    void renderVoice(juce::AudioBuffer<float>& buffer, int numSamples);
+    void beginFadeOut();
+    void applyParameterSnapshot();
+    void updatePanTarget();
+    
+    // Per-note expression on top of the shared parameters: bends set the
+    // pitch, pressure adds breath and timbre shifts the formants
+    void updatePitch();
+    void updateGlottalSource();
+    void updateFormantShift();
+    float getTimbreShift() const { return std::exp2 (expression.timbre - 0.5f); }
+
     VowelFilter filterData;
     ADSRData adsr;
     juce::AudioBuffer<float> isoBuffer;
+    juce::AudioBuffer<float> fadeBuffer;    // Tail of a stolen note or the old program, faded out over a few ms
     OscData osc; // Handles both sawtooth and glottal oscillators internally
     juce::dsp::Gain<float> gain;
     
-    // Pitch tracking for vowel filter
     MidiProcessor* midiProcessor = nullptr;
+    const ParameterSnapshot* parameters = nullptr;
+    juce::uint64 appliedGeneration = 0;
     int currentMidiNote = -1;
+    float noteFrequency = 0.0f;                 // Tuned, before pitch bend
+    int pitchWheel = 8192;
+    const NoteExpression* noteExpressionSource = nullptr;
+    NoteExpression expression;
+    float currentLevel = 0.0f;
+    int fadeSamplesRemaining = 0;
+    int fadeReadPosition = 0;
+    int fadeInSamplesRemaining = 0;         // Of the new program after a switch, over the same length
+    int renderedSamples = 0;
+    
+    // Pan stage: the voice renders mono and is placed in the stereo field on mix
+    float stereoSpread = 0.0f;
+    float notePanPosition = 0.0f;              // -1..1, from the note's pitch class
+    std::array<float, 2> panGains { 1.0f, 1.0f };
+    std::array<float, 2> targetPanGains { 1.0f, 1.0f };
+    std::array<float, 2> fadePanGains { 1.0f, 1.0f };
     
     bool isPrepared { false };
     bool useVoiceMapping = true;
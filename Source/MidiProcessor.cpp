@@ -6,170 +6,231 @@
  ==============================================================================
 */
 #include "MidiProcessor.h"
+#include "Data/VowelFilter.h"
 
-void MidiProcessor::process(juce::MidiBuffer& midiMessages)
+MidiProcessor::MidiProcessor()
 {
-    // Handle CC messages from encoders
-    for (const juce::MidiMessageMetadata metadata : midiMessages)
+    // Oscillator page (CC 20-23)
+    mapController(20, &MidiProcessor::handleRangedController, &openQuotient, 0.3f, 0.7f, "OPENQUOT");
+    mapController(21, &MidiProcessor::handleRangedController, &asymmetry, 0.1f, 2.0f, "ASYMMETRY");
+    mapController(22, &MidiProcessor::handleRangedController, &breathiness, 0.0f, 1.0f, "BREATHINESS");
+    mapController(23, &MidiProcessor::handleRangedController, &tenseness, 0.0f, 1.0f, "TENSENESS");
+    
+    // Vowel page (CC 30-36)
+    mapController(30, &MidiProcessor::handleRangedController, &formantShift, 0.5f, 2.0f, "FORMANTSHIFT");
+    mapController(31, &MidiProcessor::handleRangedController, &formantSpread, 0.5f, 2.0f, "FORMANTSPREAD");
+    mapController(32, &MidiProcessor::handleRangedController, &bandwidthScale, 0.5f, 3.0f, "BANDWIDTHSCALE");
+    mapController(33, &MidiProcessor::handleRangedController, &resonanceGain, 0.1f, 2.0f, "RESONANCEGAIN");
+    mapController(34, &MidiProcessor::handleVowelSelect, nullptr, 0.0f, 0.0f, "VOWELTYPE");
+    mapController(35, &MidiProcessor::handleRangedController, &vowelX, 0.0f, 1.0f, "VOWELX");
+    mapController(36, &MidiProcessor::handleRangedController, &vowelY, 0.0f, 1.0f, "VOWELY");
+    
+    // Bank select for program changes (CC 0)
+    mapController(0, &MidiProcessor::handleBankSelect, nullptr, 0.0f, 0.0f, nullptr);
+    
+    // Page indicator (CC 119)
+    mapController(119, &MidiProcessor::handlePageChange, nullptr, 0.0f, 0.0f, nullptr);
+}
+
+MidiProcessor::~MidiProcessor()
+{
+    stopTimer();
+}
+
+void MidiProcessor::setApvts(juce::AudioProcessorValueTreeState* apvtsPtr)
+{
+    stopTimer();
+    apvts = apvtsPtr;
+    numNotifiedParameters = 0;
+    
+    for (auto& mapping : controllerMappings)
+        mapping.notification = mapping.parameterID != nullptr ? addNotification(mapping.parameterID) : -1;
+    
+    vowelXNotification = addNotification("VOWELX");
+    vowelYNotification = addNotification("VOWELY");
+    
+    // Fast enough that automation lanes follow the encoders smoothly
+    if (apvts != nullptr)
+        startTimerHz(60);
+}
+
+int MidiProcessor::addNotification(const char* parameterID)
+{
+    auto* parameter = apvts != nullptr ? apvts->getParameter(parameterID) : nullptr;
+    
+    if (parameter == nullptr)
+        return -1;
+    
+    // Controllers that drive the same parameter share its slot
+    for (int i = 0; i < numNotifiedParameters; ++i)
+        if (pendingNotifications[static_cast<size_t>(i)].parameter == parameter)
+            return i;
+    
+    jassert(numNotifiedParameters < maxNotifiedParameters);
+    
+    if (numNotifiedParameters == maxNotifiedParameters)
+        return -1;
+    
+    pendingNotifications[static_cast<size_t>(numNotifiedParameters)].parameter = parameter;
+    return numNotifiedParameters++;
+}
+
+void MidiProcessor::notifyHost(int notification, float normalisedValue) noexcept
+{
+    if (notification < 0)
+        return;
+    
+    auto& pending = pendingNotifications[static_cast<size_t>(notification)];
+    pending.value.store(normalisedValue, std::memory_order_relaxed);
+    
+    if (pending.queued.exchange(true, std::memory_order_acq_rel))
+        return; // Already waiting; the drain picks up the new value
+    
+    const auto scope = notificationFifo.write(1);
+    notificationQueue[static_cast<size_t>(scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2)] = notification;
+}
+
+void MidiProcessor::flushHostNotifications()
+{
+    const int numReady = notificationFifo.getNumReady();
+    
+    if (numReady == 0)
+        return;
+    
+    const auto scope = notificationFifo.read(numReady);
+    
+    auto notify = [this] (int queueIndex)
     {
-        auto message = metadata.getMessage();
+        auto& pending = pendingNotifications[static_cast<size_t>(notificationQueue[static_cast<size_t>(queueIndex)])];
         
-        if (message.isController())
-        {
-            int cc = message.getControllerNumber();
-            int val = message.getControllerValue();
-            
-            switch (cc)
-            {
-                // Oscillator page (CC 20-23)
-                case 20: 
-                    openQuotient = ccToRange(val, 0.3f, 0.7f);
-                    if (apvts) apvts->getParameter("OPENQUOT")->setValueNotifyingHost(val / 127.0f);
-                    DBG("CC20 OpenQuotient: " + juce::String(openQuotient.load()));
-                    break;
-                case 21: 
-                    asymmetry = ccToRange(val, 0.1f, 2.0f);
-                    if (apvts) apvts->getParameter("ASYMMETRY")->setValueNotifyingHost(val / 127.0f);
-                    DBG("CC21 Asymmetry: " + juce::String(asymmetry.load()));
-                    break;
-                case 22: 
-                    breathiness = ccToRange(val, 0.0f, 1.0f);
-                    if (apvts) apvts->getParameter("BREATHINESS")->setValueNotifyingHost(val / 127.0f);
-                    DBG("CC22 Breathiness: " + juce::String(breathiness.load()));
-                    break;
-                case 23: 
-                    tenseness = ccToRange(val, 0.0f, 1.0f);
-                    if (apvts) apvts->getParameter("TENSENESS")->setValueNotifyingHost(val / 127.0f);
-                    DBG("CC23 Tenseness: " + juce::String(tenseness.load()));
-                    break;
-                
-                // Vowel page (CC 30-34)
-                case 30: 
-                    formantShift = ccToRange(val, 0.5f, 2.0f);
-                    if (apvts) apvts->getParameter("FORMANTSHIFT")->setValueNotifyingHost(val / 127.0f);
-                    DBG("CC30 FormantShift: " + juce::String(formantShift.load()));
-                    break;
-                case 31: 
-                    formantSpread = ccToRange(val, 0.5f, 2.0f);
-                    if (apvts) apvts->getParameter("FORMANTSPREAD")->setValueNotifyingHost(val / 127.0f);
-                    DBG("CC31 FormantSpread: " + juce::String(formantSpread.load()));
-                    break;
-                case 32: 
-                    bandwidthScale = ccToRange(val, 0.5f, 3.0f);
-                    if (apvts) apvts->getParameter("BANDWIDTHSCALE")->setValueNotifyingHost(val / 127.0f);
-                    DBG("CC32 BandwidthScale: " + juce::String(bandwidthScale.load()));
-                    break;
-                case 33: 
-                    resonanceGain = ccToRange(val, 0.1f, 2.0f);
-                    if (apvts) apvts->getParameter("RESONANCEGAIN")->setValueNotifyingHost(val / 127.0f);
-                    DBG("CC33 ResonanceGain: " + juce::String(resonanceGain.load()));
-                    break;
-                case 34: 
-                    vowelType = val / 26;
-                    if (apvts) apvts->getParameter("VOWELTYPE")->setValueNotifyingHost(val / 127.0f);
-                    DBG("CC34 VowelType: " + juce::String(vowelType.load()));
-                    break;
-                
-                // Page indicator (CC 119)
-                case 119: 
-                    currentPage = val; 
-                    DBG("Page changed to: " + juce::String(val == 0 ? "OSCILLATOR" : "VOWEL"));
-                    break;
-            }
-        }
-    }
+        // Unqueue before reading, so a change landing in between queues again
+        pending.queued.store(false, std::memory_order_release);
+        pending.parameter->setValueNotifyingHost(pending.value.load(std::memory_order_acquire));
+    };
+    
+    for (int i = 0; i < scope.blockSize1; ++i)
+        notify(scope.startIndex1 + i);
     
+    for (int i = 0; i < scope.blockSize2; ++i)
+        notify(scope.startIndex2 + i);
+}
 
+void MidiProcessor::timerCallback()
+{
+    flushHostNotifications();
+    applyPendingProgram();
+}
 
-    if (!scalaFileLoaded)
-    {
-        // No Scala file loaded, just log and pass through unchanged
-        for (const juce::MidiMessageMetadata metadata : midiMessages)
-        {
-            auto message = metadata.getMessage();
-            DBG(message.getDescription());
-        }
-        return;
-    }
+void MidiProcessor::applyPendingProgram()
+{
+    const int program = pendingProgram.exchange(-1);
+    
+    if (program >= 0 && (onProgramChange == nullptr || ! onProgramChange(program)))
+        selectLibraryScale(program);
+}
+
+void MidiProcessor::mapController(int cc, ControllerHandler handler, std::atomic<float>* target,
+                                  float minimum, float maximum, const char* parameterID)
+{
+    controllerMappings[static_cast<size_t>(cc)] = { handler, target, minimum, maximum, parameterID, -1 };
+}
+
+void MidiProcessor::process(const juce::MidiBuffer& midiMessages, bool acquireTuning)
+{
+    // Held for the whole block; a tuning swapped in meanwhile applies from
+    // the next. Voices look their notes up in it as they start.
+    if (acquireTuning)
+        pickUpTuning();
     
-    // Create a new buffer for modified messages
-    juce::MidiBuffer processedMessages;
+    const bool retune = activeTuning->retunes();
     
     for (const juce::MidiMessageMetadata metadata : midiMessages)
     {
-        auto message = metadata.getMessage();
-        DBG(message.getDescription());
+        logMidiMessage(metadata);
         
-        if (message.isNoteOn() || message.isNoteOff())
+        const auto* bytes = metadata.data;
+        const int status = metadata.numBytes == 3 ? bytes[0] & 0xf0 : 0;
+        
+        if (status == 0xb0)
         {
-            int originalMidiNote = message.getNoteNumber();
-            double targetFrequency = midiNoteToFrequency(originalMidiNote);
-            
-            // Find the closest MIDI note to this frequency
-            int closestMidiNote = frequencyToClosestMidiNote(targetFrequency);
-            
-            // Calculate pitch bend needed to reach exact frequency
-            int pitchBendValue = calculatePitchBendForFrequency(closestMidiNote, targetFrequency);
+            const auto& mapping = controllerMappings[bytes[1] & 0x7f];
             
-            DBG("MIDI note " + juce::String(originalMidiNote) + 
-                " -> Target freq: " + juce::String(targetFrequency, 2) + "Hz" +
-                " -> Closest note: " + juce::String(closestMidiNote) + 
-                " -> Pitch bend: " + juce::String(pitchBendValue));
-            
-            // Add pitch bend message first (if needed)
-            if (pitchBendValue != 8192) // 8192 is center/no bend
-            {
-                auto pitchBendMsg = juce::MidiMessage::pitchWheel(message.getChannel(), pitchBendValue);
-                pitchBendMsg.setTimeStamp(metadata.samplePosition);
-                processedMessages.addEvent(pitchBendMsg, metadata.samplePosition);
-            }
-            
-            // Create modified note message with closest MIDI note
-            juce::MidiMessage modifiedMessage;
-            if (message.isNoteOn())
-            {
-                modifiedMessage = juce::MidiMessage::noteOn(message.getChannel(), 
-                                                          closestMidiNote, 
-                                                          message.getVelocity());
-            }
-            else
-            {
-                modifiedMessage = juce::MidiMessage::noteOff(message.getChannel(), 
-                                                           closestMidiNote, 
-                                                           message.getVelocity());
-            }
-            modifiedMessage.setTimeStamp(metadata.samplePosition);
-            processedMessages.addEvent(modifiedMessage, metadata.samplePosition);
+            if (mapping.handler != nullptr)
+                (this->*mapping.handler)(mapping, bytes[1] & 0x7f, bytes[2] & 0x7f, metadata.samplePosition);
         }
-        else
+        else if (metadata.numBytes == 2 && (bytes[0] & 0xf0) == 0xc0)
+        {
+            handleProgramChange(bytes[1] & 0x7f, metadata.samplePosition);
+        }
+        else if (retune && status == 0x90 && bytes[2] != 0 && logger != nullptr)
         {
-            // Pass through other MIDI messages unchanged
-            processedMessages.addEvent(message, metadata.samplePosition);
+            logger->log(RealtimeLogger::Severity::debug, RealtimeLogger::tuningCategory,
+                        RealtimeLogger::Event::noteTuned, metadata.samplePosition,
+                        bytes[1], 0, 0, activeTuning->table.getFrequency(bytes[1]));
         }
     }
+}
+
+void MidiProcessor::handleRangedController(const ControllerMapping& mapping, int cc, int value, int samplePosition)
+{
+    mapping.target->store(ccToRange(value, mapping.minimum, mapping.maximum));
+    notifyHost(mapping.notification, value / 127.0f);
+    logControllerChange(mapping.parameterID, cc, value, samplePosition, mapping.target->load());
+}
+
+void MidiProcessor::handleVowelSelect(const ControllerMapping& mapping, int cc, int value, int samplePosition)
+{
+    vowelType = value / 26;
+    notifyHost(mapping.notification, value / 127.0f);
+    
+    // Picking a vowel jumps to its point in the vowel space
+    const auto position = VowelFilter::getVowelPosition(static_cast<VowelFilter::VowelType>(
+        juce::jlimit(0, VowelFilter::NumVowels - 1, vowelType.load())));
+    vowelX = position.x;
+    vowelY = position.y;
+    notifyHost(vowelXNotification, position.x);
+    notifyHost(vowelYNotification, position.y);
     
-    // Replace the original buffer with our processed one
-    midiMessages = processedMessages;
+    logControllerChange(mapping.parameterID, cc, value, samplePosition, static_cast<float>(vowelType.load()));
+}
+
+void MidiProcessor::handlePageChange(const ControllerMapping&, int, int value, int samplePosition)
+{
+    currentPage = value;
+    if (logger) logger->log(RealtimeLogger::Severity::debug, RealtimeLogger::parameterCategory,
+                            RealtimeLogger::Event::pageChange, samplePosition, value);
 }
 
-int MidiProcessor::frequencyToClosestMidiNote(double frequency)
+void MidiProcessor::handleBankSelect(const ControllerMapping&, int cc, int value, int samplePosition)
 {
-    // Convert frequency back to closest MIDI note number
-    return juce::roundToInt(69.0 + 12.0 * std::log2(frequency / 440.0));
+    programBank = value;
+    logControllerChange("BANKSELECT", cc, value, samplePosition, static_cast<float>(value));
 }
 
-int MidiProcessor::calculatePitchBendForFrequency(int midiNote, double targetFrequency)
+void MidiProcessor::handleProgramChange(int program, int samplePosition)
 {
-    double midiNoteFreq = juce::MidiMessage::getMidiNoteInHertz(midiNote);
-    double cents = 1200.0 * std::log2(targetFrequency / midiNoteFreq);
+    pendingProgram.store(programBank * 128 + program);
     
-    // Convert cents to pitch bend value (assuming ±2 semitone range = ±200 cents)
-    // Pitch bend range: 0-16383, center is 8192
-    double bendRange = 200.0; // ±200 cents (2 semitones)
-    int pitchBendValue = 8192 + juce::roundToInt((cents / bendRange) * 8191.0);
+    if (logger) logger->log(RealtimeLogger::Severity::debug, RealtimeLogger::tuningCategory,
+                            RealtimeLogger::Event::programChange, samplePosition, program, programBank);
+}
+
+void MidiProcessor::logControllerChange(const char* name, int cc, int value, int samplePosition, float mappedValue)
+{
+    if (logger) logger->log(RealtimeLogger::Severity::debug, RealtimeLogger::parameterCategory,
+                            RealtimeLogger::Event::controllerChange, samplePosition, cc, value, 0, mappedValue, name);
+}
+
+void MidiProcessor::logMidiMessage(const juce::MidiMessageMetadata& metadata)
+{
+    if (logger == nullptr || metadata.numBytes > 3)
+        return;
     
-    // Clamp to valid range
-    return juce::jlimit(0, 16383, pitchBendValue);
+    const auto* bytes = metadata.data;
+    logger->log(RealtimeLogger::Severity::debug, RealtimeLogger::midiCategory, RealtimeLogger::Event::midiMessage,
+                metadata.samplePosition, bytes[0],
+                metadata.numBytes > 1 ? bytes[1] : 0,
+                metadata.numBytes > 2 ? bytes[2] : 0);
 }
 
 void MidiProcessor::loadScalaFile()
@@ -178,7 +239,7 @@ void MidiProcessor::loadScalaFile()
     
     auto chooserFlags = juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles;
     
-    scalaFileChooser = std::make_unique<juce::FileChooser>("Select a Scala file", juce::File{}, "*.scl");
+    scalaFileChooser = std::make_unique<juce::FileChooser>("Select a Scala file", juce::File{}, "*.scl;*.isotun");
     
     scalaFileChooser->launchAsync(chooserFlags, [this](const juce::FileChooser& fc)
     {
@@ -186,45 +247,50 @@ void MidiProcessor::loadScalaFile()
         auto file = fc.getResult();
         
         if (file.existsAsFile())
-        {
-            DBG("Selected file: " + file.getFullPathName());
-            std::ifstream scalaFile(file.getFullPathName().toStdString());
-            
-            if (scalaFile.is_open())
-            {
-                DBG("File opened successfully, parsing...");
-                try 
-                {
-                    currentScale = scala::read_scl(scalaFile);
-                    scalaFileLoaded = true;
-                    DBG("Scala file loaded successfully: " + file.getFileName());
-                }
-                catch (const std::exception& e)
-                {
-                    DBG("Error loading Scala file: " + juce::String(e.what()));
-                    scalaFileLoaded = false;
-                }
-                scalaFile.close();
-            }
-            else
-            {
-                DBG("Failed to open file for reading");
-            }
-        }
+            loadScalaFileAsync(file);
         else
-        {
             DBG("No file selected or file chooser was cancelled");
-        }
     });
 }
 
+bool MidiProcessor::loadScalaFile(const juce::File& file)
+{
+    DBG("Loading Scala file: " + file.getFullPathName());
+    scala::scale scale;
+    
+    const bool loaded = readTuningFile(file, TuningArchive::Kind::scale,
+                                       [&scale] (const char* text, size_t size) { scale = scala::read_scl(text, size); },
+                                       [&scale] (const TuningArchive& archive, int entry) { scale = archive.getScale(entry); });
+    
+    if (! loaded)
+        return false;
+    
+    // Keep whichever mapping is current, even if it changed while parsing
+    auto shared = std::make_shared<const scala::scale>(std::move(scale));
+    
+    tuning.update([&shared] (const TuningState& current)
+    {
+        return std::make_unique<TuningState>(shared, current.getKeyboardMapping());
+    });
+    
+    setScaleName(file.getFileNameWithoutExtension(), {});
+    
+    DBG("Scala file loaded successfully: " + file.getFileName());
+    return true;
+}
+
+void MidiProcessor::loadScalaFileAsync(const juce::File& file)
+{
+    tuningLoader.addJob([this, file] { loadScalaFile(file); });
+}
+
 void MidiProcessor::loadKbmFile()
 {
     DBG("loadKbmFile() called - creating file chooser");
     
     auto chooserFlags = juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles;
     
-    kbmFileChooser = std::make_unique<juce::FileChooser>("Select a KBM file", juce::File{}, "*.kbm");
+    kbmFileChooser = std::make_unique<juce::FileChooser>("Select a KBM file", juce::File{}, "*.kbm;*.isotun");
     
     kbmFileChooser->launchAsync(chooserFlags, [this](const juce::FileChooser& fc)
     {
@@ -232,66 +298,354 @@ void MidiProcessor::loadKbmFile()
         auto file = fc.getResult();
         
         if (file.existsAsFile())
+            loadKbmFileAsync(file);
+        else
+            DBG("No KBM file selected or file chooser was cancelled");
+    });
+}
+
+bool MidiProcessor::loadKbmFile(const juce::File& file)
+{
+    DBG("Loading KBM file: " + file.getFullPathName());
+    scala::kbm mapping;
+    
+    const bool loaded = readTuningFile(file, TuningArchive::Kind::keyboardMapping,
+                                       [&mapping] (const char* text, size_t size) { mapping = scala::read_kbm(text, size); },
+                                       [&mapping] (const TuningArchive& archive, int entry) { mapping = archive.getKeyboardMapping(entry); });
+    
+    if (! loaded)
+        return false;
+    
+    tuning.update([&mapping] (const TuningState& current)
+    {
+        return std::make_unique<TuningState>(current.scale, &mapping);
+    });
+    
+    sendChangeMessage();
+    
+    DBG("KBM file loaded successfully: " + file.getFileName());
+    return true;
+}
+
+void MidiProcessor::loadKbmFileAsync(const juce::File& file)
+{
+    tuningLoader.addJob([this, file] { loadKbmFile(file); });
+}
+
+bool MidiProcessor::selectLibraryScale(int index)
+{
+    const auto entries = scaleLibrary->getEntries();
+    
+    if (! juce::isPositiveAndBelow(index, static_cast<int>(entries->size())))
+        return false;
+    
+    const auto& entry = (*entries)[static_cast<size_t>(index)];
+    
+    tuning.update([&entry] (const TuningState& current)
+    {
+        return std::make_unique<TuningState>(entry.scale, current.getKeyboardMapping());
+    });
+    
+    setScaleName(entry.name, entry.file);
+    return true;
+}
+
+bool MidiProcessor::stepLibraryScale(int delta, const ScaleLibrary::Filter& filter)
+{
+    const auto entries = scaleLibrary->getEntries();
+    const auto matches = ScaleLibrary::search(*entries, filter);
+    
+    if (matches.empty())
+        return false;
+    
+    // From outside the matches, forwards starts at the first and backwards at the last
+    juce::File currentFile;
+    
+    {
+        const juce::ScopedLock sl(scaleNameLock);
+        currentFile = libraryScaleFile;
+    }
+    
+    const int current = ScaleLibrary::indexOf(*entries, currentFile);
+    const auto position = std::find(matches.begin(), matches.end(), current);
+    const int numMatches = static_cast<int>(matches.size());
+    int next;
+    
+    if (position == matches.end())
+        next = delta > 0 ? 0 : numMatches - 1;
+    else
+        next = ((static_cast<int>(position - matches.begin()) + delta) % numMatches + numMatches) % numMatches;
+    
+    return selectLibraryScale(matches[static_cast<size_t>(next)]);
+}
+
+int MidiProcessor::getLibraryScaleIndex() const
+{
+    const juce::ScopedLock sl(scaleNameLock);
+    return libraryScaleFile == juce::File() ? -1 : ScaleLibrary::indexOf(*scaleLibrary->getEntries(), libraryScaleFile);
+}
+
+juce::String MidiProcessor::getScaleName() const
+{
+    const juce::ScopedLock sl(scaleNameLock);
+    return scaleName;
+}
+
+void MidiProcessor::setScaleName(const juce::String& name, const juce::File& libraryFile)
+{
+    {
+        const juce::ScopedLock sl(scaleNameLock);
+        scaleName = name;
+        libraryScaleFile = libraryFile;
+    }
+    
+    sendChangeMessage();
+}
+
+void MidiProcessor::writeControllerState(juce::OutputStream& stream) const
+{
+    // (controller, value) pairs: controllers added later are skipped by
+    // older builds, and ones missing from older states keep their defaults
+    auto holdsValue = [] (const ControllerMapping& mapping)
+    {
+        return mapping.target != nullptr
+            || mapping.handler == &MidiProcessor::handleVowelSelect
+            || mapping.handler == &MidiProcessor::handlePageChange;
+    };
+    
+    stream.writeInt(static_cast<int>(std::count_if(controllerMappings.begin(), controllerMappings.end(), holdsValue)));
+    
+    for (int cc = 0; cc < static_cast<int>(controllerMappings.size()); ++cc)
+    {
+        const auto& mapping = controllerMappings[static_cast<size_t>(cc)];
+        
+        if (! holdsValue(mapping))
+            continue;
+        
+        float value;
+        
+        if (mapping.target != nullptr)
+            value = mapping.target->load();
+        else if (mapping.handler == &MidiProcessor::handleVowelSelect)
+            value = static_cast<float>(vowelType.load());
+        else
+            value = static_cast<float>(currentPage.load());
+        
+        stream.writeByte(static_cast<char>(cc));
+        stream.writeFloat(value);
+    }
+}
+
+std::vector<MidiProcessor::ControllerValue> MidiProcessor::readControllerState(juce::InputStream& stream)
+{
+    std::vector<ControllerValue> values;
+    
+    for (int c = stream.readInt(); c > 0 && stream.getNumBytesRemaining() >= 5; --c)
+    {
+        const int cc = static_cast<juce::uint8>(stream.readByte()) & 0x7f;
+        values.push_back({ cc, stream.readFloat() });
+    }
+    
+    return values;
+}
+
+void MidiProcessor::setControllerValues(const std::vector<ControllerValue>& values)
+{
+    for (const auto& saved : values)
+    {
+        const auto& mapping = controllerMappings[static_cast<size_t>(saved.controller & 0x7f)];
+        
+        if (mapping.target != nullptr)
+            mapping.target->store(juce::jlimit(mapping.minimum, mapping.maximum, saved.value));
+        else if (mapping.handler == &MidiProcessor::handleVowelSelect)
+            vowelType = juce::jlimit(0, VowelFilter::NumVowels - 1, static_cast<int>(saved.value));
+        else if (mapping.handler == &MidiProcessor::handlePageChange)
+            currentPage = static_cast<int>(saved.value);
+    }
+}
+
+void MidiProcessor::writeTuningState(juce::OutputStream& stream) const
+{
+    {
+        const juce::ScopedLock sl(scaleNameLock);
+        stream.writeString(scaleName);
+        stream.writeString(libraryScaleFile == juce::File() ? juce::String() : libraryScaleFile.getFullPathName());
+    }
+    
+    tuning.read([&stream] (const TuningState& current)
+    {
+        const auto* scale = current.getScale();
+        stream.writeBool(scale != nullptr);
+        
+        if (scale != nullptr)
         {
-            DBG("Selected KBM file: " + file.getFullPathName());
-            std::ifstream kbmFile(file.getFullPathName().toStdString());
+            stream.writeString(juce::String::fromUTF8(scale->description.c_str()));
+            stream.writeInt(static_cast<int>(scale->get_scale_length()));
             
-            if (kbmFile.is_open())
-            {
-                DBG("KBM file opened successfully, parsing...");
-                try 
-                {
-                    currentKeyboardMapping = scala::read_kbm(kbmFile);
-                    kbmFileLoaded = true;
-                    DBG("KBM file loaded successfully: " + file.getFileName());
-                }
-                catch (const std::exception& e)
-                {
-                    DBG("Error loading KBM file: " + juce::String(e.what()));
-                    kbmFileLoaded = false;
-                }
-                kbmFile.close();
-            }
-            else
-            {
-                DBG("Failed to open KBM file for reading");
-            }
+            for (size_t d = 0; d < scale->get_scale_length(); ++d)
+                stream.writeDouble(scale->get_ratio(d));
         }
-        else
+        
+        const auto* mapping = current.getKeyboardMapping();
+        stream.writeBool(mapping != nullptr);
+        
+        if (mapping != nullptr)
         {
-            DBG("No KBM file selected or file chooser was cancelled");
+            stream.writeDouble(mapping->reference_frequency);
+            stream.writeInt(mapping->map_size);
+            stream.writeInt(mapping->first_note);
+            stream.writeInt(mapping->last_note);
+            stream.writeInt(mapping->middle_note);
+            stream.writeInt(mapping->reference_note);
+            stream.writeInt(mapping->octave_degree);
+            stream.writeInt(static_cast<int>(mapping->mapping.size()));
+            
+            for (const int key : mapping->mapping)
+                stream.writeInt(key);
         }
     });
 }
 
-double MidiProcessor::midiNoteToFrequency(int midiNote)
+bool MidiProcessor::readTuningState(juce::InputStream& stream, SavedTuning& result)
 {
-    if (!scalaFileLoaded)
+    result = {};
+    result.scaleName = stream.readString();
+    
+    const auto libraryPath = stream.readString();
+    result.libraryScaleFile = juce::File::isAbsolutePath(libraryPath) ? juce::File(libraryPath) : juce::File();
+    
+    if (stream.readBool())
     {
-        // Fall back to 12-TET
-        return 440.0 * std::pow(2.0, (midiNote - 69) / 12.0);
+        scala::scale loaded;
+        loaded.description = stream.readString().toStdString();
+        
+        const int numDegrees = stream.readInt();
+        
+        if (numDegrees < 1 || stream.getNumBytesRemaining() < numDegrees * static_cast<juce::int64>(sizeof(double)))
+            return false;
+        
+        loaded.degrees.clear();
+        loaded.degrees.reserve(static_cast<size_t>(numDegrees));
+        
+        for (int d = 0; d < numDegrees; ++d)
+        {
+            const double ratio = stream.readDouble();
+            
+            if (! std::isfinite(ratio) || ratio <= 0.0)
+                return false;
+            
+            loaded.degrees.emplace_back(ratio, 1.0);
+        }
+        
+        result.scale = std::make_shared<const scala::scale>(std::move(loaded));
+    }
+    
+    if (stream.readBool())
+    {
+        scala::kbm loaded;
+        loaded.reference_frequency = stream.readDouble();
+        loaded.map_size = stream.readInt();
+        loaded.first_note = stream.readInt();
+        loaded.last_note = stream.readInt();
+        loaded.middle_note = stream.readInt();
+        loaded.reference_note = stream.readInt();
+        loaded.octave_degree = stream.readInt();
+        
+        const int numKeys = stream.readInt();
+        
+        // The tuning table wraps keys by map_size, so it has to match the
+        // keys actually saved
+        if (! std::isfinite(loaded.reference_frequency) || loaded.reference_frequency <= 0.0
+            || loaded.map_size < 0 || numKeys != loaded.map_size
+            || stream.getNumBytesRemaining() < numKeys * static_cast<juce::int64>(sizeof(int)))
+            return false;
+        
+        loaded.mapping.reserve(static_cast<size_t>(numKeys));
+        
+        for (int k = 0; k < numKeys; ++k)
+            loaded.add_mapping(stream.readInt());
+        
+        result.mapping = std::make_shared<const scala::kbm>(std::move(loaded));
     }
     
-    // Simple Scala conversion for now
-    double referenceFreq = 440.0;
-    int middleNote = 60; // C4
+    return true;
+}
+
+void MidiProcessor::setTuning(const SavedTuning& saved, bool async)
+{
+    // Scale and mapping go in as one tuning, so no block plays the new
+    // scale under the old mapping
+    auto apply = [this, saved]
+    {
+        if (saved.built != nullptr)
+            tuning.publish(std::make_unique<TuningState>(*saved.built));
+        else
+            tuning.publish(std::make_unique<TuningState>(saved.scale, saved.mapping.get()));
+        
+        setScaleName(saved.scaleName, saved.libraryScaleFile);
+    };
     
-    int noteOffset = midiNote - middleNote;
-    int scaleLength = static_cast<int>(currentScale.get_scale_length()) - 1;
+    // A tuning built in advance is only copied, so it goes in right away
+    if (async && saved.built == nullptr)
+        tuningLoader.addJob(apply);
+    else
+        apply();
+}
+
+bool MidiProcessor::waitForPendingLoads(int timeoutMs) const
+{
+    const auto deadline = juce::Time::getMillisecondCounter() + static_cast<juce::uint32>(juce::jmax(0, timeoutMs));
     
-    if (scaleLength <= 0) return referenceFreq;
+    while (tuningLoader.getNumJobs() > 0)
+    {
+        if (timeoutMs >= 0 && juce::Time::getMillisecondCounter() >= deadline)
+            return false;
+        
+        juce::Thread::sleep(1);
+    }
     
-    int octaves = noteOffset / scaleLength;
-    int scaleDegree = noteOffset % scaleLength;
+    return true;
+}
+
+bool MidiProcessor::readTuningFile(const juce::File& file, TuningArchive::Kind kind,
+                                   const std::function<void(const char*, size_t)>& parseText,
+                                   const std::function<void(const TuningArchive&, int)>& readEntry)
+{
+    // Compiled files take the first entry of the kind asked for
+    if (TuningArchive::isArchive(file))
+    {
+        juce::String error;
+        const auto archive = TuningArchive::loadFromFile(file, error);
+        const int entry = archive != nullptr ? archive->findFirst(kind) : -1;
+        
+        if (entry < 0)
+        {
+            DBG("Error loading tuning archive: " + (archive != nullptr ? juce::String("no matching entry") : error));
+            return false;
+        }
+        
+        readEntry(*archive, entry);
+        return true;
+    }
+    
+    // Text is parsed straight out of the mapping, no copy
+    juce::MemoryMappedFile mapped(file, juce::MemoryMappedFile::readOnly);
     
-    if (scaleDegree < 0)
+    if (mapped.getData() == nullptr)
     {
-        scaleDegree += scaleLength;
-        octaves--;
+        DBG("Failed to open file for reading");
+        return false;
     }
     
-    double ratio = currentScale.get_ratio(scaleDegree + 1); // +1 because index 0 is 1/1
-    ratio *= std::pow(2.0, octaves);
+    try
+    {
+        parseText(static_cast<const char*>(mapped.getData()), mapped.getSize());
+    }
+    catch (const std::exception& e)
+    {
+        DBG("Error loading tuning file: " + juce::String(e.what()));
+        return false;
+    }
     
-    return referenceFreq * ratio;
-}
\ No newline at end of file
+    return true;
+}
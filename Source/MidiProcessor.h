@@ -8,17 +8,118 @@
 #pragma once
 #include "JuceHeader.h"
 #include "Data/ScalaFile.h"
+#include "Data/ScaleLibrary.h"
+#include "Data/TuningArchive.h"
+#include "Data/TuningTable.h"
+#include "Utility/RealtimeLogger.h"
+#include "Utility/RealtimePublisher.h"
 
-class MidiProcessor
+// Sends a change message whenever a new scale or mapping has been swapped in
+class MidiProcessor : public juce::ChangeBroadcaster,
+                      private juce::Timer
 {
 public:
-    void process(juce::MidiBuffer& midiMessages);
-    void setApvts(juce::AudioProcessorValueTreeState* apvtsPtr) { apvts = apvtsPtr; }
+    MidiProcessor();
+    ~MidiProcessor() override;
     
-    // Scala file management
+    // Handles encoder CCs and picks up the latest tuning for the block,
+    // unless the caller does that itself with pickUpTuning(). Notes pass
+    // through untouched: voices get their tuned pitch from
+    // midiNoteToFrequency(). Audio thread only; never allocates.
+    void process(const juce::MidiBuffer& midiMessages, bool acquireTuning = true);
+    void pickUpTuning() noexcept { activeTuning = tuning.acquire(); }
+    
+    // Looks up the parameters CCs are mirrored to, once. CC changes reach
+    // the host and editor from the message thread, never the audio thread.
+    void setApvts(juce::AudioProcessorValueTreeState* apvtsPtr);
+    
+    // Sends queued CC changes to the host now rather than on the next timer
+    // tick. Message thread only.
+    void flushHostNotifications();
+    void setLogger(RealtimeLogger* loggerPtr) { logger = loggerPtr; }
+    
+    // Scala file management: choose a file, then load it in the background
     void loadScalaFile();
     void loadKbmFile();
-    double midiNoteToFrequency(int midiNote);
+    
+    // Parse and build the tuning on a background thread, then swap it in.
+    // A file that fails to load leaves the current tuning playing.
+    void loadScalaFileAsync(const juce::File& file);
+    void loadKbmFileAsync(const juce::File& file);
+    
+    // Synchronous versions for callers without a GUI; return false on failure.
+    // Take .scl/.kbm text or a compiled TuningArchive, whose first scale or
+    // mapping is used.
+    bool loadScalaFile(const juce::File& file);
+    bool loadKbmFile(const juce::File& file);
+    
+    // The shared scale library. Picking one of its scales swaps in a tuning
+    // built from the preloaded degrees: no file access and no parsing.
+    // Message thread only.
+    ScaleLibrary& getScaleLibrary() noexcept { return *scaleLibrary; }
+    bool selectLibraryScale(int index);
+    
+    // Moves delta scales on from the current one through the scales that
+    // match filter, wrapping around. Message thread only.
+    bool stepLibraryScale(int delta, const ScaleLibrary::Filter& filter = {});
+    
+    // Index of the current scale in the library's latest entries, -1 if it
+    // didn't come from the library
+    int getLibraryScaleIndex() const;
+    
+    // The scale's file name without extension, or empty for 12-TET
+    juce::String getScaleName() const;
+    
+    // Plugin state, written into sections of the plugin's BinaryState. The
+    // controller state is what the encoders last set; the tuning state embeds
+    // the scale's degrees and the whole mapping, so a session doesn't depend
+    // on the files still being where they were. Message thread only.
+    void writeControllerState(juce::OutputStream& stream) const;
+    void writeTuningState(juce::OutputStream& stream) const;
+    
+    struct ControllerValue
+    {
+        int controller;
+        float value;
+    };
+    
+    static std::vector<ControllerValue> readControllerState(juce::InputStream& stream);
+    void setControllerValues(const std::vector<ControllerValue>& values);
+    
+    // A tuning read back from a state. built is the tuning ready to play, if
+    // something made it in advance; presets do.
+    struct SavedTuning
+    {
+        std::shared_ptr<const scala::scale> scale;
+        std::shared_ptr<const scala::kbm> mapping;
+        juce::String scaleName;
+        juce::File libraryScaleFile;
+        std::shared_ptr<const TuningState> built;
+    };
+    
+    // False if the section is damaged or would build an unplayable tuning
+    static bool readTuningState(juce::InputStream& stream, SavedTuning& result);
+    
+    // Swaps scale and mapping in together. A tuning that isn't built yet is
+    // built on the loader thread, or right away if async is false.
+    void setTuning(const SavedTuning& saved, bool async);
+    
+    // For offline tools and benchmarks only: waits for queued loads to land
+    bool waitForPendingLoads(int timeoutMs) const;
+    
+    // Called with bank * 128 + program for every MIDI program change, from
+    // wherever applyPendingProgram runs. If it's unset or returns false, the
+    // program selects a library scale instead.
+    std::function<bool(int program)> onProgramChange;
+    
+    // Switches to the last program a MIDI program change asked for, if any.
+    // The timer calls it on the message thread; offline renders, which can't
+    // wait for the timer, call it between blocks.
+    void applyPendingProgram();
+    
+    // Tuned frequency of a key under the tuning picked up for the block, 0 if
+    // the keyboard mapping leaves it unmapped. O(1); audio thread only.
+    double midiNoteToFrequency(int midiNote) const noexcept { return activeTuning->table.getFrequency(midiNote); }
     
     // CC values from encoders - Oscillator page (CC 20-23)
     std::atomic<float> openQuotient{0.6f};
@@ -26,25 +127,95 @@ public:
     std::atomic<float> breathiness{0.1f};
     std::atomic<float> tenseness{0.8f};
     
-    // CC values from encoders - Vowel page (CC 30-34)
+    // CC values from encoders - Vowel page (CC 30-36)
     std::atomic<float> formantShift{1.0f};
     std::atomic<float> formantSpread{1.0f};
     std::atomic<float> bandwidthScale{1.0f};
     std::atomic<float> resonanceGain{1.0f};
     std::atomic<int> vowelType{1};
+    std::atomic<float> vowelX{0.0f};    // Position in the vowel space, front to back
+    std::atomic<float> vowelY{0.5f};    // Close to open
     
     // Current page (CC 119)
     std::atomic<int> currentPage{0};
 
 private:
     juce::AudioProcessorValueTreeState* apvts = nullptr;
-    scala::scale currentScale;
-    scala::kbm currentKeyboardMapping;
-    bool scalaFileLoaded = false;
-    bool kbmFileLoaded = false;
+    RealtimeLogger* logger = nullptr;
+    
+    juce::SharedResourcePointer<ScaleLibrary> scaleLibrary;
+    
+    // Program change picks bank * 128 + program. The audio thread only
+    // records it; applyPendingProgram makes the switch.
+    int programBank = 0;
+    std::atomic<int> pendingProgram { -1 };
+    
+    // What the current scale is, for the editor. Set by whichever thread
+    // loaded it.
+    mutable juce::CriticalSection scaleNameLock;
+    juce::String scaleName;
+    juce::File libraryScaleFile;
+    void setScaleName(const juce::String& name, const juce::File& libraryFile);
+    
+    // Replaced whole whenever a scale or mapping loads; only process() reads it
+    RealtimePublisher<TuningState> tuning { std::make_unique<TuningState>() };
+    const TuningState* activeTuning = tuning.acquire();
+    
+    // CC dispatch: one entry per controller number, empty for unused ones
+    struct ControllerMapping;
+    using ControllerHandler = void (MidiProcessor::*)(const ControllerMapping&, int cc, int value, int samplePosition);
+    
+    struct ControllerMapping
+    {
+        ControllerHandler handler = nullptr;
+        std::atomic<float>* target = nullptr;   // Ranged controllers only
+        float minimum = 0.0f;
+        float maximum = 1.0f;
+        const char* parameterID = nullptr;      // APVTS parameter mirrored to the host
+        int notification = -1;                  // Its slot in pendingNotifications
+    };
+    
+    std::array<ControllerMapping, 128> controllerMappings;
+    
+    void mapController(int cc, ControllerHandler handler, std::atomic<float>* target,
+                       float minimum, float maximum, const char* parameterID);
+    void handleRangedController(const ControllerMapping& mapping, int cc, int value, int samplePosition);
+    void handleVowelSelect(const ControllerMapping& mapping, int cc, int value, int samplePosition);
+    void handlePageChange(const ControllerMapping& mapping, int cc, int value, int samplePosition);
+    void handleBankSelect(const ControllerMapping& mapping, int cc, int value, int samplePosition);
+    void handleProgramChange(int program, int samplePosition);
+    void logControllerChange(const char* name, int cc, int value, int samplePosition, float mappedValue);
+    
+    // CC-driven parameter changes on their way to the host. The audio thread
+    // stores the latest value and queues the slot only if it isn't queued
+    // already, so the FIFO holds each parameter at most once and can't fill
+    // up; the message thread drains it on a timer.
+    struct PendingNotification
+    {
+        juce::RangedAudioParameter* parameter = nullptr;
+        std::atomic<float> value { 0.0f };      // Normalised
+        std::atomic<bool> queued { false };
+    };
     
-    int frequencyToClosestMidiNote(double frequency);
-    int calculatePitchBendForFrequency(int midiNote, double targetFrequency);
+    static constexpr int maxNotifiedParameters = 16;
+    std::array<PendingNotification, maxNotifiedParameters> pendingNotifications;
+    std::array<int, maxNotifiedParameters + 1> notificationQueue {};
+    juce::AbstractFifo notificationFifo { maxNotifiedParameters + 1 };
+    int numNotifiedParameters = 0;
+    int vowelXNotification = -1;
+    int vowelYNotification = -1;
+    
+    int addNotification(const char* parameterID);
+    void notifyHost(int notification, float normalisedValue) noexcept;
+    void timerCallback() override;
+    
+    void logMidiMessage(const juce::MidiMessageMetadata& metadata);
+    
+    // Maps the file and hands it to parseText, or to readEntry with the
+    // first entry of kind if it's an archive. False if it can't be read.
+    static bool readTuningFile(const juce::File& file, TuningArchive::Kind kind,
+                               const std::function<void(const char*, size_t)>& parseText,
+                               const std::function<void(const TuningArchive&, int)>& readEntry);
     
     // Helper to map CC value (0-127) to parameter range
     float ccToRange(int ccValue, float min, float max)
@@ -55,4 +226,8 @@ private:
     // Keep FileChooser objects alive during async operations
     std::unique_ptr<juce::FileChooser> scalaFileChooser;
     std::unique_ptr<juce::FileChooser> kbmFileChooser;
+    
+    // One thread, so loads land in the order they were asked for. Declared
+    // last so pending loads finish before anything they touch goes away.
+    juce::ThreadPool tuningLoader { 1 };
 };
\ No newline at end of file
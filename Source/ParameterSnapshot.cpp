@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    ParameterSnapshot.cpp
+    Created: 17 Oct 2026 1:20:14pm
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "ParameterSnapshot.h"
+#include "MidiProcessor.h"
+
+ParameterSnapshotBuilder::ParameterSnapshotBuilder(juce::AudioProcessorValueTreeState& apvts, MidiProcessor& midiProcessor)
+    : midi(midiProcessor)
+    , oscWaveType(apvts.getRawParameterValue("OSC1WAVETYPE"))
+    , attack(apvts.getRawParameterValue("ATTACK"))
+    , decay(apvts.getRawParameterValue("DECAY"))
+    , sustain(apvts.getRawParameterValue("SUSTAIN"))
+    , release(apvts.getRawParameterValue("RELEASE"))
+    , harmonicAlign(apvts.getRawParameterValue("HARMONICALIGN"))
+    , stereoSpread(apvts.getRawParameterValue("STEREOSPREAD"))
+    , formantSetIndex(apvts.getRawParameterValue("FORMANTSET"))
+{
+    jassert(oscWaveType && attack && decay && sustain && release && harmonicAlign && stereoSpread && formantSetIndex);
+}
+
+const ParameterSnapshot& ParameterSnapshotBuilder::update()
+{
+    // A half-applied program never reaches the voices: read everything
+    // between two looks at the sequence, and only use it if neither saw a
+    // switch under way and none finished in between
+    const auto sequence = programSequence.load(std::memory_order_acquire);
+
+    if ((sequence & 1) != 0)
+        return snapshot;
+
+    ParameterSnapshot next;
+
+    next.oscWaveType = static_cast<int>(oscWaveType->load());
+
+    // Use MIDI CC values (from encoders) for glottal params
+    next.openQuotient = midi.openQuotient.load();
+    next.asymmetry = midi.asymmetry.load();
+    next.breathiness = midi.breathiness.load();
+    next.tenseness = midi.tenseness.load();
+
+    // ADSR still from GUI
+    next.attack = attack->load();
+    next.decay = decay->load();
+    next.sustain = sustain->load();
+    next.release = release->load();
+
+    // Use MIDI CC values (from encoders) for vowel params
+    next.vowelPosition = { midi.vowelX.load(), midi.vowelY.load() };
+    next.formantSet = &formantLibrary->getLibrary()->getSet(static_cast<int>(formantSetIndex->load()));
+    next.formantShift = midi.formantShift.load();
+    next.formantSpread = midi.formantSpread.load();
+    next.bandwidthScale = midi.bandwidthScale.load();
+    next.resonanceGain = midi.resonanceGain.load();
+
+    // Harmonic align still from GUI
+    next.harmonicAlignment = harmonicAlign->load() > 0.5f;
+    next.stereoSpread = stereoSpread->load();
+
+    juce::uint32 dirty = 0;
+
+    if (next.oscWaveType != snapshot.oscWaveType)
+        dirty |= ParameterSnapshot::oscillatorDirty;
+
+    if (next.openQuotient != snapshot.openQuotient || next.asymmetry != snapshot.asymmetry
+        || next.breathiness != snapshot.breathiness || next.tenseness != snapshot.tenseness)
+        dirty |= ParameterSnapshot::glottalDirty;
+
+    if (next.attack != snapshot.attack || next.decay != snapshot.decay
+        || next.sustain != snapshot.sustain || next.release != snapshot.release)
+        dirty |= ParameterSnapshot::envelopeDirty;
+
+    if (next.vowelPosition != snapshot.vowelPosition || next.formantSet != snapshot.formantSet || next.formantShift != snapshot.formantShift
+        || next.formantSpread != snapshot.formantSpread || next.bandwidthScale != snapshot.bandwidthScale
+        || next.harmonicAlignment != snapshot.harmonicAlignment)
+        dirty |= ParameterSnapshot::formantDirty;
+
+    if (next.resonanceGain != snapshot.resonanceGain)
+        dirty |= ParameterSnapshot::resonanceDirty;
+
+    if (next.stereoSpread != snapshot.stereoSpread)
+        dirty |= ParameterSnapshot::stereoDirty;
+
+    // A program's tuning is published inside its bracket too, so it is
+    // picked up in the same window as the values that go with it
+    midi.pickUpTuning();
+
+    if (programSequence.load(std::memory_order_acquire) != sequence)
+        return snapshot;
+
+    if (sequence != appliedProgramSequence)
+    {
+        if (dirty != 0)
+            dirty |= ParameterSnapshot::programDirty;
+
+        appliedProgramSequence = sequence;
+    }
+
+    if (dirty != 0)
+    {
+        next.dirty = dirty;
+        next.generation = snapshot.generation + 1;
+        snapshot = next;
+    }
+
+    return snapshot;
+}
@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+    ParameterSnapshot.h
+    Created: 17 Oct 2026 1:20:14pm
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Data/OscData.h"
+#include "Data/VowelFilter.h"
+
+class MidiProcessor;
+
+// Every synthesis parameter for one block, built once by the processor and
+// read by all voices through a pointer. Voices use the dirty bits to skip
+// setters - and filter rebuilds - for anything that didn't change.
+struct ParameterSnapshot
+{
+    enum DirtyFlags : juce::uint32
+    {
+        oscillatorDirty = 1 << 0,   // Wave type
+        glottalDirty    = 1 << 1,   // Open quotient, asymmetry, breathiness, tenseness
+        envelopeDirty   = 1 << 2,   // ADSR
+        formantDirty    = 1 << 3,   // Anything that needs new filter coefficients
+        resonanceDirty  = 1 << 4,   // Output gain of the formant bank only
+        stereoDirty     = 1 << 5,   // Pan stage
+        programDirty    = 1 << 6,   // A whole program at once: sounding voices crossfade
+        allDirty        = 0xffffffff
+    };
+
+    // Oscillator
+    int oscWaveType = OscData::GLOTTAL;
+
+    // Glottal source (MIDI CC)
+    float openQuotient = 0.6f;
+    float asymmetry = 0.7f;
+    float breathiness = 0.1f;
+    float tenseness = 0.8f;
+
+    // Envelope (GUI)
+    float attack = 0.1f;
+    float decay = 0.1f;
+    float sustain = 1.0f;
+    float release = 0.4f;
+
+    // Vowel filter (MIDI CC, harmonic alignment from GUI)
+    juce::Point<float> vowelPosition = VowelFilter::getVowelPosition(VowelFilter::E);
+    const FormantSet* formantSet = nullptr;     // nullptr keeps the voice's current set
+    float formantShift = 1.0f;
+    float formantSpread = 1.0f;
+    float bandwidthScale = 1.0f;
+    float resonanceGain = 1.0f;
+    bool harmonicAlignment = false;
+
+    // Pan stage (GUI): 0 keeps every voice centred, 1 spreads them across the field
+    float stereoSpread = 0.0f;
+
+    // Fields changed since the previous generation
+    juce::uint32 dirty = allDirty;
+
+    // Bumped whenever anything changes; a voice that skipped a generation
+    // can't trust the dirty bits and applies everything
+    juce::uint64 generation = 1;
+};
+
+// Owns the cached parameter pointers and the current snapshot. update() runs
+// once per block on the audio thread: no string lookups, no allocation.
+class ParameterSnapshotBuilder
+{
+public:
+    ParameterSnapshotBuilder(juce::AudioProcessorValueTreeState& apvts, MidiProcessor& midiProcessor);
+
+    const ParameterSnapshot& update();
+    const ParameterSnapshot& get() const { return snapshot; }
+
+    // Brackets a program switch on the message thread. update() keeps the
+    // last complete snapshot while one is under way, then picks up every
+    // change it made in a single generation, flagged programDirty.
+    void beginProgramChange() noexcept { programSequence.fetch_add(1, std::memory_order_acq_rel); }
+    void endProgramChange() noexcept { programSequence.fetch_add(1, std::memory_order_acq_rel); }
+
+private:
+    MidiProcessor& midi;
+
+    // Odd while a program switch is being applied
+    std::atomic<juce::uint32> programSequence { 0 };
+    juce::uint32 appliedProgramSequence = 0;
+
+    std::atomic<float>* oscWaveType;
+    std::atomic<float>* attack;
+    std::atomic<float>* decay;
+    std::atomic<float>* sustain;
+    std::atomic<float>* release;
+    std::atomic<float>* harmonicAlign;
+    std::atomic<float>* stereoSpread;
+    std::atomic<float>* formantSetIndex;
+    
+    // Resolved every block, so a newly loaded library reaches the voices on the next one
+    juce::SharedResourcePointer<FormantLibraryCache> formantLibrary;
+
+    ParameterSnapshot snapshot;
+};
@@ -13,7 +13,7 @@
 ISODRONEAudioProcessorEditor::ISODRONEAudioProcessorEditor(ISODRONEAudioProcessor& p)
     : AudioProcessorEditor(&p), audioProcessor(p), osc(audioProcessor.apvts, "OSC1WAVETYPE"), adsr(audioProcessor.apvts)
 {
-    setSize(450, 950); // More width and height for better spacing
+    setSize(450, 995); // More width and height for better spacing
     
     // Create parameter attachments and setup custom value display
     openQuotientAttachment = std::make_unique<SliderAttachment>(audioProcessor.apvts, "OPENQUOT", openQuotientKnob);
@@ -98,7 +98,6 @@ ISODRONEAudioProcessorEditor::ISODRONEAudioProcessorEditor(ISODRONEAudioProcesso
     loadScalaButton.setButtonText("Load .scl");
     loadScalaButton.onClick = [this] { 
         audioProcessor.midiProcessor.loadScalaFile(); 
-        scalaStatusLabel.setText("Scala file loaded", juce::dontSendNotification);
     };
     addAndMakeVisible(loadScalaButton);
 
@@ -108,14 +107,82 @@ ISODRONEAudioProcessorEditor::ISODRONEAudioProcessorEditor(ISODRONEAudioProcesso
     };
     addAndMakeVisible(loadKbmButton);
 
-    scalaStatusLabel.setText("12-TET (default)", juce::dontSendNotification);
     scalaStatusLabel.setJustificationType(juce::Justification::centred);
     scalaStatusLabel.setFont(juce::Font(12.0f));
     addAndMakeVisible(scalaStatusLabel);
+
+    // Setup scale library browser
+    scaleSearchBox.setTextToShowWhenEmpty("Search scales", juce::Colours::grey);
+    scaleSearchBox.onTextChange = [this] { refreshScaleList(); };
+    addAndMakeVisible(scaleSearchBox);
+
+    scaleSelector.setTextWhenNothingSelected("Scale library");
+    scaleSelector.setTextWhenNoChoicesAvailable("No scales found");
+    scaleSelector.onChange = [this] {
+        const int listed = scaleSelector.getSelectedId() - 1;
+
+        if (listedScales != nullptr && juce::isPositiveAndBelow(listed, static_cast<int>(listedScales->size())))
+        {
+            // The library may have rescanned since the list was filled
+            auto& midiProcessor = audioProcessor.midiProcessor;
+            const auto entries = midiProcessor.getScaleLibrary().getEntries();
+            midiProcessor.selectLibraryScale(ScaleLibrary::indexOf(*entries, (*listedScales)[static_cast<size_t>(listed)].file));
+        }
+    };
+    addAndMakeVisible(scaleSelector);
+
+    previousScaleButton.onClick = [this] { audioProcessor.midiProcessor.stepLibraryScale(-1, getScaleFilter()); };
+    nextScaleButton.onClick = [this] { audioProcessor.midiProcessor.stepLibraryScale(1, getScaleFilter()); };
+    addAndMakeVisible(previousScaleButton);
+    addAndMakeVisible(nextScaleButton);
+
+    audioProcessor.midiProcessor.addChangeListener(this);
+    audioProcessor.midiProcessor.getScaleLibrary().addChangeListener(this);
+    refreshScaleList();
+    updateScaleStatus();
 }
 
 ISODRONEAudioProcessorEditor::~ISODRONEAudioProcessorEditor()
 {
+    audioProcessor.midiProcessor.getScaleLibrary().removeChangeListener(this);
+    audioProcessor.midiProcessor.removeChangeListener(this);
+}
+
+//==============================================================================
+ScaleLibrary::Filter ISODRONEAudioProcessorEditor::getScaleFilter() const
+{
+    ScaleLibrary::Filter filter;
+    filter.text = scaleSearchBox.getText();
+    return filter;
+}
+
+void ISODRONEAudioProcessorEditor::refreshScaleList()
+{
+    listedScales = audioProcessor.midiProcessor.getScaleLibrary().getEntries();
+    scaleSelector.clear(juce::dontSendNotification);
+
+    for (auto index : ScaleLibrary::search(*listedScales, getScaleFilter()))
+    {
+        const auto& entry = (*listedScales)[static_cast<size_t>(index)];
+        scaleSelector.addItem(entry.name + " (" + juce::String(entry.numNotes) + ")", index + 1);
+    }
+
+    scaleSelector.setSelectedId(audioProcessor.midiProcessor.getLibraryScaleIndex() + 1, juce::dontSendNotification);
+}
+
+void ISODRONEAudioProcessorEditor::updateScaleStatus()
+{
+    const auto name = audioProcessor.midiProcessor.getScaleName();
+    scalaStatusLabel.setText(name.isNotEmpty() ? name : juce::String("12-TET (default)"), juce::dontSendNotification);
+    scaleSelector.setSelectedId(audioProcessor.midiProcessor.getLibraryScaleIndex() + 1, juce::dontSendNotification);
+}
+
+void ISODRONEAudioProcessorEditor::changeListenerCallback(juce::ChangeBroadcaster* source)
+{
+    if (source == &audioProcessor.midiProcessor.getScaleLibrary())
+        refreshScaleList();
+
+    updateScaleStatus();
 }
 
 //==============================================================================
@@ -145,7 +212,7 @@ void ISODRONEAudioProcessorEditor::resized()
     auto bounds = getLocalBounds().reduced(15, 15); // More padding
     
     // 1. MICROTUNING SECTION (Top, compact)
-    auto microtuningArea = bounds.removeFromTop(70); // Taller
+    auto microtuningArea = bounds.removeFromTop(115); // Room for the scale library row
     sectionBounds.add(microtuningArea);
     layoutMicrotuningSection(microtuningArea);
     
@@ -194,7 +261,21 @@ void ISODRONEAudioProcessorEditor::layoutMicrotuningSection(juce::Rectangle<int>
     buttonRow.items.add(juce::FlexItem().withWidth(15)); // Bigger gap
     buttonRow.items.add(juce::FlexItem(scalaStatusLabel).withFlex(1).withHeight(30));
     
-    buttonRow.performLayout(content);
+    buttonRow.performLayout(content.removeFromTop(30));
+    
+    content.removeFromTop(10);
+    
+    juce::FlexBox libraryRow;
+    libraryRow.flexDirection = juce::FlexBox::Direction::row;
+    libraryRow.alignItems = juce::FlexBox::AlignItems::center;
+    
+    libraryRow.items.add(juce::FlexItem(scaleSearchBox).withWidth(110).withHeight(28));
+    libraryRow.items.add(juce::FlexItem().withWidth(8));
+    libraryRow.items.add(juce::FlexItem(previousScaleButton).withWidth(28).withHeight(28));
+    libraryRow.items.add(juce::FlexItem(scaleSelector).withFlex(1).withHeight(28));
+    libraryRow.items.add(juce::FlexItem(nextScaleButton).withWidth(28).withHeight(28));
+    
+    libraryRow.performLayout(content.removeFromTop(30));
     
     // Hide the microtuning section label for compact design
     microtuningSectionLabel.setBounds(0, 0, 0, 0);
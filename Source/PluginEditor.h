@@ -13,7 +13,8 @@
 #include "GUI/ADSRComponent.h"
 #include "GUI/OscComponent.h"
 
-class ISODRONEAudioProcessorEditor : public juce::AudioProcessorEditor
+class ISODRONEAudioProcessorEditor : public juce::AudioProcessorEditor,
+                                     private juce::ChangeListener
 {
 public:
     ISODRONEAudioProcessorEditor(ISODRONEAudioProcessor&);
@@ -47,6 +48,17 @@ private:
     juce::Label scalaStatusLabel;
     juce::Label microtuningSectionLabel;
 
+    // Scale library browser: search, pick from the matches or step through them
+    juce::TextEditor scaleSearchBox;
+    juce::ComboBox scaleSelector;
+    juce::TextButton previousScaleButton { "<" }, nextScaleButton { ">" };
+    std::shared_ptr<const ScaleLibrary::Entries> listedScales;
+
+    ScaleLibrary::Filter getScaleFilter() const;
+    void refreshScaleList();
+    void updateScaleStatus();
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
     // Parameter attachments
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     using ComboBoxAttachment = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
@@ -8,6 +8,7 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "PluginState.h"
 
 //==============================================================================
 ISODRONEAudioProcessor::ISODRONEAudioProcessor()
@@ -22,15 +23,32 @@ ISODRONEAudioProcessor::ISODRONEAudioProcessor()
                      #endif
 #endif
                      ),
-        apvts (*this, nullptr, "Parameters", createParams())
+        apvts (*this, nullptr, "Parameters", createParams()),
+        parameterSnapshot (apvts, midiProcessor)
 {
-    iso.addSound (new IsoSound());
-    iso.addVoice (new IsoVoice());
     midiProcessor.setApvts(&apvts);  // Add this
+    midiProcessor.setLogger (&logger);
+    iso.setLogger (&logger);
+    iso.setParameterSnapshot (&parameterSnapshot.get());
+    
+    // Program changes pick presets once there are any, library scales until then
+    midiProcessor.onProgramChange = [this] (int program)
+    {
+        if (presetBank->getPresets()->empty())
+            return false;
+        
+        setCurrentProgram (program);
+        updateHostDisplay (juce::AudioProcessorListener::ChangeDetails().withProgramChanged (true));
+        return true;
+    };
+    
+    presetBank->addChangeListener (this);
 }
 
 ISODRONEAudioProcessor::~ISODRONEAudioProcessor()
 {
+    presetBank->removeChangeListener (this);
+    midiProcessor.onProgramChange = nullptr;
 }
 
 //==============================================================================
@@ -73,40 +91,54 @@ double ISODRONEAudioProcessor::getTailLengthSeconds() const
 
 int ISODRONEAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    // Some hosts don't cope with 0 programs, so an empty bank still has one
+    return juce::jmax (1, static_cast<int> (presetBank->getPresets()->size()));
 }
 
 int ISODRONEAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return currentProgram;
 }
 
 void ISODRONEAudioProcessor::setCurrentProgram (int index)
 {
+    // The snapshot keeps the preset alive even if a rescan replaces it meanwhile
+    const auto presets = presetBank->getPresets();
+    
+    if (! juce::isPositiveAndBelow (index, static_cast<int> (presets->size())))
+        return;
+    
+    currentProgram = index;
+    applyState (*(*presets)[static_cast<size_t> (index)].state, ! isNonRealtime());
 }
 
 const juce::String ISODRONEAudioProcessor::getProgramName (int index)
 {
-    return {};
+    const auto presets = presetBank->getPresets();
+    return juce::isPositiveAndBelow (index, static_cast<int> (presets->size())) ? (*presets)[static_cast<size_t> (index)].name
+                                                                                : juce::String();
 }
 
 void ISODRONEAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    // Names are the preset file names
+    juce::ignoreUnused (index, newName);
+}
+
+void ISODRONEAudioProcessor::changeListenerCallback (juce::ChangeBroadcaster*)
+{
+    // The bank was rescanned: the host's program list is out of date
+    updateHostDisplay (juce::AudioProcessorListener::ChangeDetails().withProgramChanged (true));
 }
 
 //==============================================================================
 void ISODRONEAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    iso.setCurrentPlaybackSampleRate (sampleRate);
-    for (int i = 0; i < iso.getNumVoices(); i++)
-    {
-        if (auto voice = dynamic_cast<IsoVoice*>(iso.getVoice(i)))
-        {
-            voice->prepareToPlay (sampleRate, samplesPerBlock, getTotalNumOutputChannels());
-            voice->setMidiProcessor(&midiProcessor); // Connect MidiProcessor
-        }
-    }
+    // Builds the whole voice pool up front so nothing allocates in processBlock
+    iso.prepare (sampleRate, samplesPerBlock, getTotalNumOutputChannels(), &midiProcessor);
+    setLatencySamples (juce::roundToInt (iso.getLatency()));
+    preparedSampleRate = sampleRate;
+    preparedBlockSize = samplesPerBlock;
 
     // Start a continuous note
     //iso.noteOn(1, 30, 1.0f); // channel 1, middle C, full velocity
@@ -114,13 +146,49 @@ void ISODRONEAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlo
 
 void ISODRONEAudioProcessor::releaseResources()
 {   
-    for (int i = 0; i < iso.getNumVoices(); i++)
-    {
-        if (auto voice = dynamic_cast<IsoVoice*>(iso.getVoice(i)))
-        {
-            voice->reset_filter();
-        }
-    }
+    iso.resetVoices();
+}
+
+void ISODRONEAudioProcessor::setVoiceCount (int numVoices)
+{
+    iso.setVoiceCount (numVoices);
+
+    if (preparedSampleRate <= 0.0)
+        return; // Picked up by the next prepareToPlay
+
+    // Resizing the pool allocates, so keep the audio thread out while we do it
+    suspendProcessing (true);
+    iso.prepare (preparedSampleRate, preparedBlockSize, getTotalNumOutputChannels(), &midiProcessor);
+    suspendProcessing (false);
+}
+
+void ISODRONEAudioProcessor::setOversamplingFactor (int factor)
+{
+    iso.setOversamplingFactor (factor);
+
+    if (preparedSampleRate <= 0.0)
+        return; // Picked up by the next prepareToPlay
+
+    // Every voice reallocates for the new rate, as when resizing the pool
+    suspendProcessing (true);
+    iso.prepare (preparedSampleRate, preparedBlockSize, getTotalNumOutputChannels(), &midiProcessor);
+    setLatencySamples (juce::roundToInt (iso.getLatency()));
+    suspendProcessing (false);
+}
+
+void ISODRONEAudioProcessor::setRenderThreads (int numThreads)
+{
+    // Starting or stopping workers must not overlap a block that is using them
+    suspendProcessing (true);
+    iso.setRenderThreads (numThreads);
+    suspendProcessing (false);
+}
+
+bool ISODRONEAudioProcessor::loadFormantLibrary (const juce::File& file, juce::String& error)
+{
+    // Voices pick the new library up through their parameter snapshot
+    juce::SharedResourcePointer<FormantLibraryCache> formantLibrary;
+    return formantLibrary->loadLibrary (file, error);
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -152,76 +220,35 @@ bool ISODRONEAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
 void ISODRONEAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    logger.nextBlock();
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
     
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    // Process MIDI first (handles CC messages)
-    midiProcessor.process(midiMessages);
-
-    // Get oscillator type
-    auto& oscWaveChoice = *apvts.getRawParameterValue("OSC1WAVETYPE");
-
-    static int lastOscChoice = -1;
-    int currentOscChoice = static_cast<int>(oscWaveChoice.load());
+    // Process MIDI first (handles CC messages); the tuning is picked up with
+    // the parameter snapshot, so a program switch brings both at once
+    midiProcessor.process (midiMessages, false);
     
-    if (currentOscChoice != lastOscChoice) {
-        DBG("ProcessBlock: Oscillator changed to " + 
-            juce::String(currentOscChoice == 0 ? "SAWTOOTH" : "GLOTTAL"));
-        lastOscChoice = currentOscChoice;
-    }
+    // Offline there may be no message loop running the timer, and a bounce
+    // outruns it anyway: a program change switches before its block renders
+    if (isNonRealtime())
+        midiProcessor.applyPendingProgram();
 
-    // Use MIDI CC values (from encoders) for glottal params
-    float oq = midiProcessor.openQuotient.load();
-    float asym = midiProcessor.asymmetry.load();
-    float breath = midiProcessor.breathiness.load();
-    float tense = midiProcessor.tenseness.load();
-
-    // ADSR still from GUI
-    auto& attack = *apvts.getRawParameterValue("ATTACK");
-    auto& decay = *apvts.getRawParameterValue("DECAY");
-    auto& sustain = *apvts.getRawParameterValue("SUSTAIN");
-    auto& release = *apvts.getRawParameterValue("RELEASE");
-
-    // Use MIDI CC values (from encoders) for vowel params
-    float fShift = midiProcessor.formantShift.load();
-    float fSpread = midiProcessor.formantSpread.load();
-    float bwScale = midiProcessor.bandwidthScale.load();
-    float resGain = midiProcessor.resonanceGain.load();
-    int vType = midiProcessor.vowelType.load();
-    
-    // Harmonic align still from GUI
-    auto& harmonicAlign = *apvts.getRawParameterValue("HARMONICALIGN");
+    // One snapshot per block; voices pick it up through their pointer and
+    // only touch what the dirty bits say has changed
+    const auto& parameters = parameterSnapshot.update();
 
-    for (int i = 0; i < iso.getNumVoices(); ++i)
+    if (parameters.generation != lastParameterGeneration)
     {
-        if (auto voice = dynamic_cast<IsoVoice*>(iso.getVoice(i)))
-        {
-            // Set oscillator type
-            voice->getOscillator().setWaveType(currentOscChoice);
-            
-            // Set glottal parameters (from MIDI CC)
-            voice->setGlottalParams(oq, asym, breath, tense);
-            
-            // Update ADSR
-            voice->update(attack.load(), decay.load(), sustain.load(), release.load());
-
-            // Update vowel filter parameters (from MIDI CC)
-            voice->setVowelType(static_cast<VowelFilter::VowelType>(vType));
-            voice->getVowelFilter().setFormantShift(fShift);
-            voice->getVowelFilter().setFormantSpread(fSpread);
-            voice->getVowelFilter().setBandwidthScale(bwScale);
-            voice->getVowelFilter().setResonanceGain(resGain);
-            voice->getVowelFilter().setHarmonicAlignment(harmonicAlign.load() > 0.5f);
-        }
+        if (parameters.dirty & ParameterSnapshot::oscillatorDirty)
+            logger.log (RealtimeLogger::Severity::info, RealtimeLogger::parameterCategory,
+                        RealtimeLogger::Event::oscillatorChanged, 0, parameters.oscWaveType);
+
+        lastParameterGeneration = parameters.generation;
     }
     
-    for (const juce::MidiMessageMetadata metadata : midiMessages)
-        if (metadata.numBytes == 3)
-            juce::Logger::writeToLog ("TimeStamp: " + juce::String (metadata.getMessage().getTimeStamp()));
-
     iso.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
 }
 
@@ -239,15 +266,105 @@ juce::AudioProcessorEditor* ISODRONEAudioProcessor::createEditor()
 //==============================================================================
 void ISODRONEAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
+    BinaryState::Writer writer;
+
+    // Every parameter by ID and normalised value, so adding, removing or
+    // reordering parameters doesn't break older states
+    auto& parameters = writer.beginSection (PluginState::parametersSection, PluginState::parametersVersion);
+    const auto& processorParameters = getParameters();
+    parameters.writeInt (processorParameters.size());
+
+    for (auto* parameter : processorParameters)
+    {
+        auto* ranged = static_cast<juce::RangedAudioParameter*> (parameter);
+        parameters.writeString (ranged->getParameterID());
+        parameters.writeFloat (ranged->getValue());
+    }
+
+    midiProcessor.writeControllerState (writer.beginSection (PluginState::controllersSection,
+                                                             PluginState::controllersVersion));
+    midiProcessor.writeTuningState (writer.beginSection (PluginState::tuningSection, PluginState::tuningVersion));
+
+    // By name as well as by index: the shared library may be a different
+    // one, or list its sets in another order, when the state comes back
+    juce::SharedResourcePointer<FormantLibraryCache> formantLibrary;
+    const auto formantSet = static_cast<int> (apvts.getRawParameterValue ("FORMANTSET")->load());
+    writer.beginSection (PluginState::formantSection, PluginState::formantVersion)
+          .writeString (formantLibrary->getLibrary()->getSet (formantSet).name);
+
+    destData = writer.finish();
 }
 
 void ISODRONEAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
+    const auto state = PluginState::read (data, static_cast<size_t> (juce::jmax (0, sizeInBytes)));
+
+    if (state == nullptr)
+    {
+        // The parameter tree saved as XML with copyXmlToBinary still loads
+        if (auto xml = getXmlFromBinary (data, sizeInBytes))
+            if (xml->hasTagName (apvts.state.getType()))
+                apvts.replaceState (juce::ValueTree::fromXml (*xml));
+
+        return;
+    }
+
+    // The tuning table is built on the loader thread and published in one
+    // swap, so a host restoring while playing never waits on it. Offline
+    // renders need the tuning in place before the first block.
+    applyState (*state, ! isNonRealtime());
+}
+
+void ISODRONEAudioProcessor::applyState (const PluginState& state, bool buildTuningAsync)
+{
+    // Voices see everything set in between in one parameter snapshot,
+    // never half of the old state and half of the new
+    parameterSnapshot.beginProgramChange();
+
+    // Values go into a copy of the parameter tree, which then replaces the
+    // live one in a single step, like any restored session, instead of as
+    // an automation write per parameter
+    auto tree = apvts.copyState();
+
+    const auto setValue = [this, &tree] (const juce::String& parameterID, float normalisedValue)
+    {
+        auto* parameter = apvts.getParameter (parameterID);
+        auto child = tree.getChildWithProperty ("id", parameterID);
+
+        if (parameter != nullptr && child.isValid())
+            child.setProperty ("value", parameter->convertFrom0to1 (normalisedValue), nullptr);
+    };
+
+    for (const auto& saved : state.parameters)
+        setValue (saved.parameterID, saved.value);
+
+    // By name: the shared library may list its sets in another order now
+    if (state.formantSetName.isNotEmpty())
+    {
+        juce::SharedResourcePointer<FormantLibraryCache> formantLibrary;
+        const auto* library = formantLibrary->getLibrary();
+
+        for (int set = 0; set < library->getNumSets(); ++set)
+        {
+            if (library->getSet (set).name == state.formantSetName)
+            {
+                setValue ("FORMANTSET", apvts.getParameter ("FORMANTSET")->convertTo0to1 (static_cast<float> (set)));
+                break;
+            }
+        }
+    }
+
+    apvts.replaceState (tree);
+    midiProcessor.setControllerValues (state.controllers);
+
+    // A preset's tuning is prebuilt and goes in right here, inside the
+    // bracket; one still to be built follows as soon as it's ready
+    if (state.hasTuning)
+        midiProcessor.setTuning (state.tuning, buildTuningAsync);
+
+    parameterSnapshot.endProgramChange();
+
+    updateHostDisplay();
 }
 
 //==============================================================================
@@ -284,6 +401,13 @@ juce::AudioProcessorValueTreeState::ParameterLayout ISODRONEAudioProcessor::crea
     params.push_back(std::make_unique<juce::AudioParameterChoice>("VOWELTYPE", "Vowel Type", 
         juce::StringArray{"A", "E", "I", "O", "U"}, 1)); // Default to E
 
+    // Continuous vowel space: front to back, close to open (E sits at 0, 0.5)
+    params.push_back(std::make_unique<juce::AudioParameterFloat>("VOWELX", "Vowel Front/Back", 
+        juce::NormalisableRange<float>{0.0f, 1.0f}, 0.0f));
+
+    params.push_back(std::make_unique<juce::AudioParameterFloat>("VOWELY", "Vowel Close/Open", 
+        juce::NormalisableRange<float>{0.0f, 1.0f}, 0.5f));
+
     params.push_back(std::make_unique<juce::AudioParameterFloat>("FORMANTSHIFT", "Formant Shift", 
         juce::NormalisableRange<float>{0.5f, 2.0f}, 1.0f));
 
@@ -298,5 +422,13 @@ juce::AudioProcessorValueTreeState::ParameterLayout ISODRONEAudioProcessor::crea
 
     params.push_back(std::make_unique<juce::AudioParameterBool>("HARMONICALIGN", "Harmonic Alignment", false));
 
+    // Index into the shared formant library; the built-in one has Classic,
+    // Soprano, Alto, Tenor, Bass and Child
+    params.push_back(std::make_unique<juce::AudioParameterInt>("FORMANTSET", "Formant Set", 0, 31, 0));
+
+    // Voices render mono and are panned by pitch class on the way out
+    params.push_back(std::make_unique<juce::AudioParameterFloat>("STEREOSPREAD", "Stereo Spread", 
+        juce::NormalisableRange<float>{0.0f, 1.0f}, 0.0f));
+
     return { params.begin(), params.end() };
 }
\ No newline at end of file
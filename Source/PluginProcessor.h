@@ -9,14 +9,16 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "IsoVoice.h"
-#include "IsoSound.h"
+#include "IsoSynthesiser.h"
 #include "MidiProcessor.h"
+#include "ParameterSnapshot.h"
+#include "PresetBank.h"
 
 //==============================================================================
 /**
 */
-class ISODRONEAudioProcessor  : public juce::AudioProcessor
+class ISODRONEAudioProcessor  : public juce::AudioProcessor,
+                                private juce::ChangeListener
 {
 public:
     //==============================================================================
@@ -46,6 +48,9 @@ public:
     double getTailLengthSeconds() const override;
 
     //==============================================================================
+    // Programs are the shared preset bank's presets. Switching swaps every
+    // parameter, controller value and the tuning in at once, and sounding
+    // voices crossfade to the new program.
     int getNumPrograms() override;
     int getCurrentProgram() override;
     void setCurrentProgram (int index) override;
@@ -59,8 +64,46 @@ public:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParams();
     MidiProcessor midiProcessor;
     
+    // Runtime log filtering (severity/category); the log itself is audio-thread safe
+    RealtimeLogger& getLogger() { return logger; }
+    
+    // Polyphony (IsoSynthesiser::minVoices to maxVoices); message thread only
+    void setVoiceCount (int numVoices);
+    int getVoiceCount() const { return iso.getVoiceCount(); }
+    
+    // Voices are rendered on this many cores (1 = audio thread only, the default)
+    void setRenderThreads (int numThreads);
+    int getRenderThreads() const { return iso.getRenderThreads(); }
+    
+    // Fixed breath noise for repeatable renders; takes effect on the next prepareToPlay
+    void setNoiseSeed (juce::int64 seed) { iso.setNoiseSeed (seed); }
+    
+    // Voices run at 1, 2, 4 or 8 times the host rate; anything above 1 adds
+    // the decimator's delay to the reported latency. Message thread only.
+    void setOversamplingFactor (int factor);
+    int getOversamplingFactor() const { return iso.getOversamplingFactor(); }
+    
+    // Formant sets come from one library shared by every instance in the
+    // process, so this switches all of them. Message thread only.
+    bool loadFormantLibrary (const juce::File& file, juce::String& error);
+    
+    PresetBank& getPresetBank() noexcept { return *presetBank; }
+    
 private:
-    juce::Synthesiser iso;
+    RealtimeLogger logger;
+    ParameterSnapshotBuilder parameterSnapshot;
+    IsoSynthesiser iso;
+    juce::uint64 lastParameterGeneration = 0;
+    double preparedSampleRate = 0.0;
+    int preparedBlockSize = 0;
+    
+    juce::SharedResourcePointer<PresetBank> presetBank;
+    int currentProgram = 0;
+    
+    // Message thread only. The tuning is built on the loader thread if it
+    // isn't built already and buildTuningAsync is set.
+    void applyState (const PluginState& state, bool buildTuningAsync);
+    void changeListenerCallback (juce::ChangeBroadcaster* source) override;
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ISODRONEAudioProcessor)
 };
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    PluginState.cpp
+    Created: 18 Oct 2026 6:04:52am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "PluginState.h"
+
+std::unique_ptr<PluginState> PluginState::read(const void* data, size_t size)
+{
+    const BinaryState::Reader reader(data, size);
+
+    if (! reader.isValid())
+        return nullptr;
+
+    auto state = std::make_unique<PluginState>();
+
+    if (const auto* section = reader.findSection(parametersSection, parametersVersion))
+    {
+        auto stream = section->createStream();
+
+        for (int p = stream.readInt(); p > 0 && ! stream.isExhausted(); --p)
+        {
+            const auto parameterID = stream.readString();
+            state->parameters.push_back({ parameterID, juce::jlimit(0.0f, 1.0f, stream.readFloat()) });
+        }
+    }
+
+    if (const auto* section = reader.findSection(controllersSection, controllersVersion))
+    {
+        auto stream = section->createStream();
+        state->controllers = MidiProcessor::readControllerState(stream);
+    }
+
+    if (const auto* section = reader.findSection(tuningSection, tuningVersion))
+    {
+        auto stream = section->createStream();
+        state->hasTuning = MidiProcessor::readTuningState(stream, state->tuning);
+    }
+
+    if (const auto* section = reader.findSection(formantSection, formantVersion))
+    {
+        auto stream = section->createStream();
+        state->formantSetName = stream.readString();
+    }
+
+    return state;
+}
@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    PluginState.h
+    Created: 18 Oct 2026 6:04:52am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "MidiProcessor.h"
+#include "Utility/BinaryState.h"
+
+// Everything getStateInformation saves, decoded from its BinaryState form.
+// Presets are kept this way with their tuning already built, so switching to
+// one copies values and swaps a table in but parses nothing.
+struct PluginState
+{
+    // State sections. Each is versioned on its own and may grow at the end;
+    // unknown ones are skipped, so a newer build's state loads here. A
+    // section saved in a newer version than the one below is skipped too.
+    static constexpr auto parametersSection = BinaryState::makeTag("PARM");
+    static constexpr auto controllersSection = BinaryState::makeTag("MIDI");
+    static constexpr auto tuningSection = BinaryState::makeTag("TUNE");
+    static constexpr auto formantSection = BinaryState::makeTag("FMNT");
+
+    static constexpr int parametersVersion = 1;
+    static constexpr int controllersVersion = 1;
+    static constexpr int tuningVersion = 1;
+    static constexpr int formantVersion = 1;
+
+    struct ParameterValue
+    {
+        juce::String parameterID;
+        float value;                // Normalised
+    };
+
+    std::vector<ParameterValue> parameters;
+    std::vector<MidiProcessor::ControllerValue> controllers;
+    bool hasTuning = false;
+    MidiProcessor::SavedTuning tuning;
+    juce::String formantSetName;    // Empty if the state didn't name one
+
+    // nullptr if data isn't a valid BinaryState. Sections that are missing
+    // or damaged are left empty, and applying the state leaves those alone.
+    static std::unique_ptr<PluginState> read(const void* data, size_t size);
+};
@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+    PresetBank.cpp
+    Created: 18 Oct 2026 6:12:30am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "PresetBank.h"
+
+PresetBank::PresetBank()
+    : BackgroundScanner("ISODRONE preset bank")
+    , directory(getDefaultDirectory())
+{
+    startScanning();
+}
+
+PresetBank::~PresetBank()
+{
+    stopScanning();
+}
+
+juce::File PresetBank::getDefaultDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+               .getChildFile("ISODRONE").getChildFile("Presets");
+}
+
+juce::File PresetBank::getDirectory() const
+{
+    const juce::ScopedLock sl(directoryLock);
+    return directory;
+}
+
+void PresetBank::setDirectory(const juce::File& directoryToScan)
+{
+    {
+        const juce::ScopedLock sl(directoryLock);
+        directory = directoryToScan;
+    }
+
+    rescan();
+}
+
+//==============================================================================
+void PresetBank::scan()
+{
+    // Presets whose file hasn't changed are kept as they are
+    const auto previous = getPresets();
+    auto next = std::make_shared<Presets>();
+
+    for (const auto& child : juce::RangedDirectoryIterator(getDirectory(), false, juce::String("*") + fileExtension,
+                                                           juce::File::findFiles))
+    {
+        if (shouldStopScanning())
+            return;
+
+        const auto& file = child.getFile();
+        const auto found = std::find_if(previous->begin(), previous->end(),
+                                        [&file] (const Preset& preset) { return preset.file == file; });
+
+        if (found != previous->end() && found->modificationTime == child.getModificationTime())
+        {
+            next->push_back(*found);
+            continue;
+        }
+
+        auto preset = readFile(file);
+        preset.modificationTime = child.getModificationTime();
+
+        if (preset.state != nullptr)
+            next->push_back(std::move(preset));
+    }
+
+    std::sort(next->begin(), next->end(), [] (const Preset& a, const Preset& b)
+    {
+        return a.name.compareNatural(b.name, false) < 0;
+    });
+
+    publish(std::move(next));
+}
+
+Preset PresetBank::readFile(const juce::File& file)
+{
+    Preset preset;
+    preset.file = file;
+    preset.name = file.getFileNameWithoutExtension();
+
+    juce::MemoryMappedFile mapped(file, juce::MemoryMappedFile::readOnly);
+
+    if (mapped.getData() == nullptr)
+        return preset;
+
+    auto state = PluginState::read(mapped.getData(), mapped.getSize());
+
+    if (state == nullptr)
+        return preset;
+
+    // Built here, once, rather than on every switch to the preset
+    if (state->hasTuning)
+        state->tuning.built = std::make_shared<const TuningState>(state->tuning.scale, state->tuning.mapping.get());
+
+    preset.state = std::move(state);
+    return preset;
+}
@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    PresetBank.h
+    Created: 18 Oct 2026 6:12:30am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginState.h"
+#include "Utility/BackgroundScanner.h"
+
+// One preset, decoded and ready to switch to
+struct Preset
+{
+    juce::File file;
+    juce::String name;              // File name without extension
+    juce::Time modificationTime;
+    std::shared_ptr<const PluginState> state;
+};
+
+// The host's program list: every .isopreset file in one directory, each a
+// plugin state as getStateInformation writes it. Files are decoded when
+// they're scanned, tuning tables and all, so a program change copies values
+// and swaps a table in but never reads or parses anything. Every instance in
+// the process shares the bank through a SharedResourcePointer.
+class PresetBank : public BackgroundScanner<std::vector<Preset>>
+{
+public:
+    using Presets = std::vector<Preset>;
+
+    static constexpr const char* fileExtension = ".isopreset";
+
+    PresetBank();
+    ~PresetBank() override;
+
+    // <user application data>/ISODRONE/Presets unless set otherwise; not
+    // searched recursively, so program numbers stay easy to follow
+    static juce::File getDefaultDirectory();
+
+    juce::File getDirectory() const;
+    void setDirectory(const juce::File& directoryToScan);
+
+    // Ordered by name, which makes program numbers follow file names. A
+    // switch looks its preset up here, so that never waits on a scan.
+    std::shared_ptr<const Presets> getPresets() const { return getSnapshot(); }
+
+private:
+    void scan() override;
+
+    static Preset readFile(const juce::File& file);
+
+    mutable juce::CriticalSection directoryLock;
+    juce::File directory;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetBank)
+};
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    BackgroundScanner.h
+    Created: 18 Oct 2026 8:05:27am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Shared by the process-wide collections that are read from disk, like the
+// scale library and the preset bank: a low priority thread runs the
+// subclass's scan() whenever a rescan is asked for, and each scan publishes
+// an immutable Snapshot. Readers on any thread take the snapshot with
+// getSnapshot() and keep it for as long as they like; listeners get a change
+// message every time a new one is published.
+//
+// Subclasses call startScanning() at the end of their constructor and
+// stopScanning() at the start of their destructor, so the thread never runs
+// against a half-built or half-destroyed object.
+template <typename Snapshot>
+class BackgroundScanner : private juce::Thread,
+                          public juce::ChangeBroadcaster
+{
+public:
+    ~BackgroundScanner() override
+    {
+        jassert(! isThreadRunning());
+    }
+
+    // Scans again on the background thread
+    void rescan()
+    {
+        scanned.reset();
+        notify();
+    }
+
+    // For offline tools and benchmarks, which need the result before they
+    // go on: waits until the scan in progress has published
+    bool waitForScan(int timeoutMs) const
+    {
+        return scanned.wait(timeoutMs);
+    }
+
+protected:
+    explicit BackgroundScanner(const juce::String& threadName)
+        : juce::Thread(threadName)
+        , snapshot(std::make_shared<const Snapshot>())
+    {
+    }
+
+    void startScanning() { startThread(juce::Thread::Priority::low); }
+    void stopScanning() { stopThread(5000); }
+
+    // Scanner thread. prepareScan() runs once before the first scan.
+    virtual void prepareScan() {}
+    virtual void scan() = 0;
+    bool shouldStopScanning() const { return threadShouldExit(); }
+
+    // Never nullptr
+    std::shared_ptr<const Snapshot> getSnapshot() const
+    {
+        const juce::ScopedLock sl(snapshotLock);
+        return snapshot;
+    }
+
+    void publish(std::shared_ptr<const Snapshot> next)
+    {
+        {
+            const juce::ScopedLock sl(snapshotLock);
+            snapshot = std::move(next);
+        }
+
+        sendChangeMessage();
+    }
+
+private:
+    void run() override
+    {
+        prepareScan();
+
+        while (! threadShouldExit())
+        {
+            scan();
+            scanned.signal();
+            wait(-1);
+        }
+    }
+
+    mutable juce::CriticalSection snapshotLock;
+    std::shared_ptr<const Snapshot> snapshot;
+    mutable juce::WaitableEvent scanned { true };
+
+    JUCE_DECLARE_NON_COPYABLE(BackgroundScanner)
+};
@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    BinaryState.cpp
+    Created: 18 Oct 2026 5:20:44am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "BinaryState.h"
+
+namespace BinaryState
+{
+    namespace
+    {
+        constexpr Tag magic = makeTag("ISOS");
+        constexpr int currentFormatVersion = 1;
+        constexpr size_t headerSize = 8;
+        constexpr size_t sectionHeaderSize = 12;    // Tag, version, size
+    }
+
+    //==========================================================================
+    Writer::Writer()
+    {
+        stream.writeInt(static_cast<int>(magic));
+        stream.writeInt(currentFormatVersion);
+    }
+
+    juce::OutputStream& Writer::beginSection(Tag tag, int sectionVersion)
+    {
+        endSection();
+
+        stream.writeInt(static_cast<int>(tag));
+        stream.writeInt(sectionVersion);
+        sizePosition = stream.getPosition();
+        stream.writeInt(0);   // Patched by endSection()
+        return stream;
+    }
+
+    void Writer::endSection()
+    {
+        if (sizePosition < 0)
+            return;
+
+        const auto end = stream.getPosition();
+        stream.setPosition(sizePosition);
+        stream.writeInt(static_cast<int>(end - sizePosition - 4));
+        stream.setPosition(end);
+        sizePosition = -1;
+    }
+
+    juce::MemoryBlock Writer::finish()
+    {
+        endSection();
+        return stream.getMemoryBlock();
+    }
+
+    //==========================================================================
+    Reader::Reader(const void* data, size_t size)
+    {
+        const auto* bytes = static_cast<const char*>(data);
+
+        if (data == nullptr || size < headerSize
+            || static_cast<Tag>(juce::ByteOrder::littleEndianInt(bytes)) != magic)
+            return;
+
+        formatVersion = static_cast<int>(juce::ByteOrder::littleEndianInt(bytes + 4));
+
+        // A different container layout: even the section table can't be trusted
+        if (formatVersion != currentFormatVersion)
+            return;
+
+        size_t position = headerSize;
+
+        while (position + sectionHeaderSize <= size)
+        {
+            Section section;
+            section.tag = static_cast<Tag>(juce::ByteOrder::littleEndianInt(bytes + position));
+            section.version = static_cast<int>(juce::ByteOrder::littleEndianInt(bytes + position + 4));
+            section.size = juce::ByteOrder::littleEndianInt(bytes + position + 8);
+            section.data = bytes + position + sectionHeaderSize;
+
+            if (section.size > size - position - sectionHeaderSize)
+                return;   // Truncated: trust none of it
+
+            sections.push_back(section);
+            position += sectionHeaderSize + section.size;
+        }
+
+        valid = position == size;
+    }
+
+    const Reader::Section* Reader::findSection(Tag tag, int maxVersion) const noexcept
+    {
+        for (const auto& section : sections)
+            if (section.tag == tag)
+                return section.version >= 1 && section.version <= maxVersion ? &section : nullptr;
+
+        return nullptr;
+    }
+}
@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    BinaryState.h
+    Created: 18 Oct 2026 5:20:44am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// A compact container for plugin state: an 8 byte header (magic and format
+// version) followed by tagged sections, each with its own version and byte
+// size. Readers look sections up by tag and skip the ones they don't know,
+// and a section may grow new fields at its end, so states saved by a newer
+// build still load in an older one. A section's version only goes up when
+// its existing fields change, and the format version only when the
+// container itself does; readers refuse versions newer than they know.
+// Little-endian throughout.
+namespace BinaryState
+{
+    using Tag = juce::uint32;
+
+    constexpr Tag makeTag(const char (&name)[5]) noexcept
+    {
+        return static_cast<Tag>(static_cast<juce::uint8>(name[0]))
+             | static_cast<Tag>(static_cast<juce::uint8>(name[1])) << 8
+             | static_cast<Tag>(static_cast<juce::uint8>(name[2])) << 16
+             | static_cast<Tag>(static_cast<juce::uint8>(name[3])) << 24;
+    }
+
+    class Writer
+    {
+    public:
+        Writer();
+
+        // Starts a section, finishing the previous one. Write its fields to
+        // the stream returned.
+        juce::OutputStream& beginSection(Tag tag, int sectionVersion = 1);
+
+        // Finishes the last section and hands over the state
+        juce::MemoryBlock finish();
+
+    private:
+        void endSection();
+
+        juce::MemoryOutputStream stream;
+        juce::int64 sizePosition = -1;
+    };
+
+    class Reader
+    {
+    public:
+        // Doesn't copy: data must outlive the reader
+        Reader(const void* data, size_t size);
+
+        // False if the magic doesn't match, the format version is newer than
+        // this build knows or the section table is damaged
+        bool isValid() const noexcept { return valid; }
+        int getFormatVersion() const noexcept { return formatVersion; }
+
+        struct Section
+        {
+            Tag tag;
+            int version;
+            const char* data;
+            size_t size;
+
+            juce::MemoryInputStream createStream() const { return { data, size, false }; }
+        };
+
+        // nullptr if there is no such section, or if its version is newer
+        // than maxVersion, the last one the caller can parse
+        const Section* findSection(Tag tag, int maxVersion) const noexcept;
+
+    private:
+        std::vector<Section> sections;
+        int formatVersion = 0;
+        bool valid = false;
+    };
+}
@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    RealtimeLogger.cpp
+    Created: 17 Oct 2026 5:02:51pm
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "RealtimeLogger.h"
+
+namespace
+{
+    const char* severityName(RealtimeLogger::Severity severity)
+    {
+        switch (severity)
+        {
+            case RealtimeLogger::Severity::debug:   return "DEBUG";
+            case RealtimeLogger::Severity::info:    return "INFO";
+            case RealtimeLogger::Severity::warning: return "WARN";
+            case RealtimeLogger::Severity::error:   return "ERROR";
+        }
+
+        return "";
+    }
+}
+
+RealtimeLogger::RealtimeLogger(int capacity)
+    : juce::Thread("ISODRONE log writer")
+    , fifo(capacity)
+    , records(static_cast<size_t>(capacity))
+   #if JUCE_DEBUG
+    , minimumSeverity(static_cast<int>(Severity::debug))
+   #else
+    , minimumSeverity(static_cast<int>(Severity::warning))
+   #endif
+{
+    startThread();
+}
+
+RealtimeLogger::~RealtimeLogger()
+{
+    stopThread(1000);
+    drain();
+}
+
+void RealtimeLogger::run()
+{
+    while (! threadShouldExit())
+    {
+        drain();
+        wait(20);
+    }
+}
+
+void RealtimeLogger::drain()
+{
+    const int numReady = fifo.getNumReady();
+
+    if (numReady > 0)
+    {
+        const auto scope = fifo.read(numReady);
+
+        for (int i = 0; i < scope.blockSize1; ++i)
+            juce::Logger::writeToLog(format(records[static_cast<size_t>(scope.startIndex1 + i)]));
+
+        for (int i = 0; i < scope.blockSize2; ++i)
+            juce::Logger::writeToLog(format(records[static_cast<size_t>(scope.startIndex2 + i)]));
+    }
+
+    if (const int numDropped = dropped.exchange(0))
+        juce::Logger::writeToLog("[WARN] Realtime log overflow, dropped " + juce::String(numDropped) + " records");
+}
+
+juce::String RealtimeLogger::format(const Record& record)
+{
+    juce::String text;
+    text << "[" << severityName(record.severity) << "] block " << static_cast<int>(record.blockIndex)
+         << " @" << record.samplePosition << ": ";
+
+    switch (record.event)
+    {
+        case Event::midiMessage:
+        {
+            // Only short messages are logged, so the bytes always fit
+            const auto status = static_cast<juce::uint8>(record.a);
+
+            switch (juce::MidiMessage::getMessageLengthFromFirstByte(status))
+            {
+                case 1:  text << juce::MidiMessage(record.a).getDescription(); break;
+                case 2:  text << juce::MidiMessage(record.a, record.b).getDescription(); break;
+                default: text << juce::MidiMessage(record.a, record.b, record.c).getDescription(); break;
+            }
+
+            break;
+        }
+
+        case Event::controllerChange:
+            text << "CC" << record.a << " " << (record.name != nullptr ? record.name : "Unmapped") << ": " << juce::String(record.value)
+                 << " (value " << record.b << ")";
+            break;
+
+        case Event::pageChange:
+            text << "Page changed to: " << (record.a == 0 ? "OSCILLATOR" : "VOWEL");
+            break;
+
+        case Event::noteTuned:
+            text << "MIDI note " << record.a << " -> " << (record.value > 0.0f ? juce::String(record.value, 2) + "Hz"
+                                                                             : juce::String("unmapped"));
+            break;
+
+        case Event::oscillatorChanged:
+            text << "Oscillator changed to " << (record.a == 0 ? "SAWTOOTH" : "GLOTTAL");
+            break;
+
+        case Event::voiceStolen:
+            text << "Voice stolen for note " << record.a << " on channel " << record.b;
+            break;
+
+        case Event::programChange:
+            text << "Program change " << record.a << " bank " << record.b;
+            break;
+    }
+
+    return text;
+}
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    RealtimeLogger.h
+    Created: 17 Oct 2026 5:02:51pm
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Logging that is safe to call from the audio callback. The audio thread
+// pushes small fixed-size binary records into a preallocated lock-free FIFO;
+// a background thread formats them and hands them to juce::Logger.
+//
+// Single producer: only the audio thread may call log().
+class RealtimeLogger : private juce::Thread
+{
+public:
+    enum class Severity : juce::uint8
+    {
+        debug = 0,
+        info,
+        warning,
+        error
+    };
+
+    enum Category : juce::uint32
+    {
+        midiCategory       = 1 << 0,   // Raw incoming MIDI
+        parameterCategory  = 1 << 1,   // CC-driven and snapshot parameter changes
+        tuningCategory     = 1 << 2,   // Scala tuning of played notes
+        voiceCategory      = 1 << 3,   // Voice allocation
+        allCategories      = 0xffffffff
+    };
+
+    enum class Event : juce::uint8
+    {
+        midiMessage,        // a, b, c = raw bytes of a message up to 3 bytes long
+        controllerChange,   // a = CC number, b = CC value, value = mapped parameter value, name = what it controls
+        pageChange,         // a = page
+        noteTuned,          // a = note, value = tuned frequency in Hz, 0 if unmapped
+        oscillatorChanged,  // a = wave type
+        voiceStolen,        // a = note, b = channel
+        programChange       // a = program, b = bank
+    };
+
+    struct Record
+    {
+        juce::uint32 blockIndex;
+        juce::uint32 category;
+        int samplePosition;
+        int a, b, c;
+        float value;
+        const char* name;   // String literal or nullptr; only the pointer is stored
+        Event event;
+        Severity severity;
+    };
+
+    explicit RealtimeLogger(int capacity = 4096);
+    ~RealtimeLogger() override;
+
+    // Audio thread. Never blocks or allocates; drops the record if the FIFO is full.
+    void log(Severity severity, Category category, Event event, int samplePosition,
+             int a = 0, int b = 0, int c = 0, float value = 0.0f, const char* name = nullptr) noexcept
+    {
+        if (! isEnabled(severity, category))
+            return;
+
+        const auto scope = fifo.write(1);
+
+        if (scope.blockSize1 + scope.blockSize2 == 0)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        auto& record = records[static_cast<size_t>(scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2)];
+        record = { currentBlock, static_cast<juce::uint32>(category), samplePosition, a, b, c, value, name, event, severity };
+    }
+
+    // Audio thread, once per processBlock, so records can be grouped by block
+    void nextBlock() noexcept { ++currentBlock; }
+
+    // Runtime filter; safe from any thread
+    void setMinimumSeverity(Severity severity) noexcept { minimumSeverity.store(static_cast<int>(severity)); }
+    void setCategoryMask(juce::uint32 mask) noexcept { categoryMask.store(mask); }
+
+    bool isEnabled(Severity severity, Category category) const noexcept
+    {
+        return static_cast<int>(severity) >= minimumSeverity.load(std::memory_order_relaxed)
+            && (categoryMask.load(std::memory_order_relaxed) & category) != 0;
+    }
+
+private:
+    void run() override;
+    void drain();
+    static juce::String format(const Record& record);
+
+    juce::AbstractFifo fifo;
+    std::vector<Record> records;
+
+    std::atomic<int> minimumSeverity;
+    std::atomic<juce::uint32> categoryMask { allCategories };
+    std::atomic<int> dropped { 0 };
+    juce::uint32 currentBlock = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RealtimeLogger)
+};
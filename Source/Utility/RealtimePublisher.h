@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    RealtimePublisher.h
+    Created: 18 Oct 2026 1:47:52am
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Hands immutable objects from any number of non-realtime writers to a
+// single realtime reader, RCU style. A writer builds a complete new object
+// and publishes it with one atomic store; the reader never locks, never
+// allocates and never frees.
+//
+// Reclamation is deferred: the reader announces the object it is using on
+// every acquire(), and writers only free a replaced object once it is
+// neither current nor announced. Whatever is still in use stays in the
+// retired list until a later publish, or until the publisher is destroyed.
+template <typename ObjectType>
+class RealtimePublisher
+{
+public:
+    explicit RealtimePublisher(std::unique_ptr<ObjectType> initial)
+        : owned(std::move(initial))
+    {
+        jassert(owned != nullptr);
+        current.store(owned.get());
+    }
+
+    // Reader side. The result stays valid until the next acquire() from the
+    // same thread. Lock-free; only loops if a publish races with it.
+    const ObjectType* acquire() noexcept
+    {
+        auto* object = current.load();
+
+        for (;;)
+        {
+            inUse.store(object);
+            auto* latest = current.load();
+
+            if (latest == object)
+                return object;
+
+            object = latest;
+        }
+    }
+
+    // Writer side. makeNext receives the current object and returns its
+    // replacement, or nullptr to leave things as they are. Writers are
+    // serialised, so read-modify-write updates never lose each other's work.
+    template <typename Function>
+    bool update(Function&& makeNext)
+    {
+        const juce::ScopedLock sl(writeLock);
+        std::unique_ptr<ObjectType> next = makeNext(static_cast<const ObjectType&>(*owned));
+
+        if (next == nullptr)
+            return false;
+
+        retired.push_back(std::move(owned));
+        owned = std::move(next);
+        current.store(owned.get());
+        collectGarbage();
+        return true;
+    }
+
+    bool publish(std::unique_ptr<ObjectType> next)
+    {
+        return update([&next] (const ObjectType&) { return std::move(next); });
+    }
+
+    // Writer side read of the latest object, for threads other than the reader
+    template <typename Function>
+    auto read(Function&& function) const
+    {
+        const juce::ScopedLock sl(writeLock);
+        return function(static_cast<const ObjectType&>(*owned));
+    }
+
+private:
+    void collectGarbage()
+    {
+        auto* announced = inUse.load();
+
+        retired.erase(std::remove_if(retired.begin(), retired.end(),
+                                     [announced] (const auto& object) { return object.get() != announced; }),
+                      retired.end());
+    }
+
+    std::unique_ptr<ObjectType> owned;
+    std::vector<std::unique_ptr<ObjectType>> retired;
+    std::atomic<const ObjectType*> current { nullptr };
+    std::atomic<const ObjectType*> inUse { nullptr };
+    juce::CriticalSection writeLock;
+
+    JUCE_DECLARE_NON_COPYABLE(RealtimePublisher)
+};
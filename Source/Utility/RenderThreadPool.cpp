@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+    RenderThreadPool.cpp
+    Created: 17 Oct 2026 6:40:18pm
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#include "RenderThreadPool.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
+namespace
+{
+    inline void cpuRelax() noexcept
+    {
+       #if JUCE_INTEL
+        _mm_pause();
+       #elif JUCE_ARM && (defined (__GNUC__) || defined (__clang__))
+        __asm__ __volatile__ ("yield");
+       #endif
+    }
+}
+
+class RenderThreadPool::Worker : public juce::Thread
+{
+public:
+    Worker(RenderThreadPool& poolToUse, int participantIndex)
+        : juce::Thread("ISODRONE render " + juce::String(participantIndex))
+        , pool(poolToUse)
+        , participant(participantIndex)
+    {
+    }
+
+    void wake() noexcept
+    {
+        // Only pay for the kernel call when the worker has actually gone to sleep
+        if (sleeping.load())
+            wakeEvent.signal();
+    }
+
+    void stop()
+    {
+        signalThreadShouldExit();
+        wakeEvent.signal();
+        stopThread(1000);
+    }
+
+    void run() override
+    {
+        juce::ScopedNoDenormals noDenormals;
+        juce::uint32 seenGeneration = pool.generation.load(std::memory_order_acquire);
+
+        while (! threadShouldExit())
+        {
+            const auto latest = pool.generation.load(std::memory_order_acquire);
+
+            if (latest == seenGeneration)
+            {
+                waitForWork(seenGeneration);
+                continue;
+            }
+
+            seenGeneration = latest;
+
+            // Paired with the caller closing the job in run(): either we see the
+            // job closed and leave it alone, or the caller sees us and waits
+            pool.activeWorkers.fetch_add(1);
+
+            if (pool.jobOpen.load())
+                pool.executeTasks(participant);
+
+            pool.activeWorkers.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+private:
+    void waitForWork(juce::uint32 seenGeneration)
+    {
+        for (int i = 0; i < pool.spinIterations; ++i)
+        {
+            if (pool.generation.load(std::memory_order_relaxed) != seenGeneration)
+                return;
+
+            cpuRelax();
+        }
+
+        sleeping.store(true);
+
+        if (pool.generation.load() == seenGeneration && ! threadShouldExit())
+            wakeEvent.wait(100);
+
+        sleeping.store(false);
+    }
+
+    RenderThreadPool& pool;
+    const int participant;
+    juce::WaitableEvent wakeEvent;
+    std::atomic<bool> sleeping { false };
+};
+
+//==============================================================================
+RenderThreadPool::RenderThreadPool(int numWorkers, int spinIterationsToUse)
+    : numParticipants(juce::jmax(0, numWorkers) + 1)
+    , spinIterations(juce::jmax(0, spinIterationsToUse))
+    , ranges(new TaskRange[static_cast<size_t>(numParticipants)])
+{
+    for (int i = 1; i < numParticipants; ++i)
+    {
+        auto* worker = workers.add(new Worker(*this, i));
+
+        // The audio callback waits on the workers, so they want the same
+        // scheduling class; not every system grants it
+        if (! worker->startRealtimeThread(juce::Thread::RealtimeOptions().withPriority(10)))
+            worker->startThread(juce::Thread::Priority::highest);
+    }
+}
+
+RenderThreadPool::~RenderThreadPool()
+{
+    for (auto* worker : workers)
+        worker->stop();
+}
+
+void RenderThreadPool::run(Job& job, int numTasks) noexcept
+{
+    if (numTasks <= 0)
+        return;
+
+    if (workers.isEmpty() || numTasks == 1)
+    {
+        for (int i = 0; i < numTasks; ++i)
+            job.perform(i);
+
+        return;
+    }
+
+    // One contiguous range per participant; the first ones take the remainder
+    const int perParticipant = numTasks / numParticipants;
+    const int remainder = numTasks % numParticipants;
+    int begin = 0;
+
+    for (int p = 0; p < numParticipants; ++p)
+    {
+        const int size = perParticipant + (p < remainder ? 1 : 0);
+        ranges[p].next.store(begin, std::memory_order_relaxed);
+        ranges[p].end.store(begin + size, std::memory_order_relaxed);
+        begin += size;
+    }
+
+    currentJob.store(&job, std::memory_order_relaxed);
+    tasksRemaining.store(numTasks, std::memory_order_relaxed);
+    jobOpen.store(true);
+    generation.fetch_add(1);
+
+    for (auto* worker : workers)
+        worker->wake();
+
+    executeTasks(0);
+
+    while (tasksRemaining.load(std::memory_order_acquire) > 0)
+        cpuRelax();
+
+    // Late workers must not start on the ranges once we return, since the
+    // next call rewrites them
+    jobOpen.store(false);
+
+    while (activeWorkers.load() > 0)
+        cpuRelax();
+}
+
+void RenderThreadPool::executeTasks(int participant) noexcept
+{
+    auto* job = currentJob.load(std::memory_order_relaxed);
+
+    for (int i = 0; i < numParticipants; ++i)
+    {
+        auto& range = ranges[(participant + i) % numParticipants];
+        const int end = range.end.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            const int task = range.next.fetch_add(1, std::memory_order_relaxed);
+
+            if (task >= end)
+                break;
+
+            job->perform(task);
+            tasksRemaining.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+}
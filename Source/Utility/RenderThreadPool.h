@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    RenderThreadPool.h
+    Created: 17 Oct 2026 6:40:18pm
+    Author:  zerocase
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// A fixed set of high priority worker threads for splitting one block's work
+// across cores. Everything is allocated in the constructor; run() never
+// allocates or locks on the audio thread.
+//
+// The tasks of a job are split into one contiguous range per participant
+// (the calling thread plus every worker). Each participant drains its own
+// range first and then steals from the others, so uneven tasks still balance.
+// Idle workers spin briefly before going to sleep, which keeps wake-up latency
+// low for back-to-back audio blocks.
+class RenderThreadPool
+{
+public:
+    struct Job
+    {
+        virtual ~Job() = default;
+
+        // Called exactly once per task index, from any participant thread
+        virtual void perform(int taskIndex) noexcept = 0;
+    };
+
+    explicit RenderThreadPool(int numWorkers, int spinIterations = 4000);
+    ~RenderThreadPool();
+
+    // Includes the calling thread
+    int getNumParticipants() const noexcept { return numParticipants; }
+
+    // Runs job.perform(0 .. numTasks - 1) and returns once every task has
+    // finished. The caller works on the job too. Audio thread only.
+    void run(Job& job, int numTasks) noexcept;
+
+private:
+    class Worker;
+
+    struct alignas(64) TaskRange
+    {
+        std::atomic<int> next { 0 };
+        std::atomic<int> end { 0 };
+    };
+
+    void executeTasks(int participant) noexcept;
+
+    const int numParticipants;
+    const int spinIterations;
+
+    std::unique_ptr<TaskRange[]> ranges;
+    juce::OwnedArray<Worker> workers;
+
+    std::atomic<Job*> currentJob { nullptr };
+    std::atomic<juce::uint32> generation { 0 };
+    std::atomic<bool> jobOpen { false };
+    alignas(64) std::atomic<int> tasksRemaining { 0 };
+    alignas(64) std::atomic<int> activeWorkers { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RenderThreadPool)
+};
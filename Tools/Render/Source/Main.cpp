@@ -0,0 +1,303 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 7:25:44pm
+    Author:  zerocase
+
+    Headless offline renderer: drives ISODRONEAudioProcessor from a Standard
+    MIDI File and streams the result to a WAV file, as fast as the machine
+    allows. No editor is created.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+#include "../../../Source/Data/GlottalWavetable.h"
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+ #include <psapi.h>
+ #pragma comment (lib, "psapi.lib")
+#else
+ #include <sys/resource.h>
+#endif
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "usage: ISODRONERender --midi <file.mid> --out <file.wav> [options]" << std::endl
+                  << std::endl
+                  << "  --state <file>     parameter state (APVTS XML or plugin state)" << std::endl
+                  << "  --scl <file>       Scala scale" << std::endl
+                  << "  --kbm <file>       Scala keyboard mapping" << std::endl
+                  << "  --formants <file>  formant library (text or binary)" << std::endl
+                  << "  --save-preset <f>  write the state the options above set up as a preset;" << std::endl
+                  << "                     without --midi and --out nothing is rendered" << std::endl
+                  << "  --rate <hz>        sample rate (default 48000)" << std::endl
+                  << "  --block <samples>  block size (default 512)" << std::endl
+                  << "  --tail <seconds>   extra time after the last MIDI event (default 5)" << std::endl
+                  << "  --voices <n>       polyphony (default " << IsoSynthesiser::defaultVoices << ")" << std::endl
+                  << "  --threads <n>      voice render threads (default 1)" << std::endl
+                  << "  --oversampling <n> run the voices at 1, 2, 4 or 8x the rate (default 1)" << std::endl
+                  << "  --bits <16|24|32>  WAV bit depth (default 24)" << std::endl;
+    }
+
+    // Peak resident set size of this process in bytes
+    juce::int64 getPeakMemoryBytes()
+    {
+       #if JUCE_WINDOWS
+        PROCESS_MEMORY_COUNTERS counters;
+
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return static_cast<juce::int64>(counters.PeakWorkingSetSize);
+
+        return 0;
+       #else
+        struct rusage usage;
+
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+
+        #if JUCE_MAC
+         return static_cast<juce::int64>(usage.ru_maxrss);          // bytes
+        #else
+         return static_cast<juce::int64>(usage.ru_maxrss) * 1024;   // kilobytes
+        #endif
+       #endif
+    }
+
+    bool loadMidiFile(const juce::File& file, juce::MidiMessageSequence& sequence)
+    {
+        juce::FileInputStream stream(file);
+        juce::MidiFile midiFile;
+
+        if (! stream.openedOk() || ! midiFile.readFrom(stream))
+            return false;
+
+        midiFile.convertTimestampTicksToSeconds();
+
+        for (int track = 0; track < midiFile.getNumTracks(); ++track)
+            sequence.addSequence(*midiFile.getTrack(track), 0.0);
+
+        sequence.sort();
+        return true;
+    }
+
+    bool loadState(const juce::File& file, ISODRONEAudioProcessor& processor)
+    {
+        if (auto xml = juce::XmlDocument::parse(file))
+        {
+            if (! xml->hasTagName(processor.apvts.state.getType()))
+                return false;
+
+            processor.apvts.replaceState(juce::ValueTree::fromXml(*xml));
+            return true;
+        }
+
+        // Not XML: treat it as a blob saved by the plugin itself
+        juce::MemoryBlock data;
+
+        if (! file.loadFileAsData(data) || data.isEmpty())
+            return false;
+
+        processor.setStateInformation(data.getData(), static_cast<int>(data.getSize()));
+        return true;
+    }
+
+    juce::File getFileOption(const juce::ArgumentList& args, const juce::String& option)
+    {
+        if (! args.containsOption(option))
+            return {};
+
+        return juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption(option));
+    }
+
+    int fail(const juce::String& message)
+    {
+        std::cerr << "error: " << message << std::endl;
+        return 1;
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    const bool savesPreset = args.containsOption("--save-preset");
+    const bool renders = args.containsOption("--midi") && args.containsOption("--out");
+
+    if (args.containsOption("--help|-h") || ! (renders || savesPreset))
+    {
+        printUsage();
+        return args.containsOption("--help|-h") ? 0 : 1;
+    }
+
+    const double sampleRate = args.containsOption("--rate") ? args.getValueForOption("--rate").getDoubleValue() : 48000.0;
+    const int blockSize = args.containsOption("--block") ? args.getValueForOption("--block").getIntValue() : 512;
+    const double tailSeconds = args.containsOption("--tail") ? args.getValueForOption("--tail").getDoubleValue() : 5.0;
+    const int bitDepth = args.containsOption("--bits") ? args.getValueForOption("--bits").getIntValue() : 24;
+
+    if (sampleRate < 8000.0 || blockSize < 1)
+        return fail("invalid sample rate or block size");
+
+    auto processor = std::make_unique<ISODRONEAudioProcessor>();
+    processor->setNonRealtime(true);
+
+    if (args.containsOption("--voices"))
+        processor->setVoiceCount(args.getValueForOption("--voices").getIntValue());
+
+    if (args.containsOption("--threads"))
+        processor->setRenderThreads(args.getValueForOption("--threads").getIntValue());
+
+    if (args.containsOption("--oversampling"))
+        processor->setOversamplingFactor(args.getValueForOption("--oversampling").getIntValue());
+
+    if (args.containsOption("--state") && ! loadState(getFileOption(args, "--state"), *processor))
+        return fail("could not read state file " + getFileOption(args, "--state").getFullPathName());
+
+    if (args.containsOption("--scl") && ! processor->midiProcessor.loadScalaFile(getFileOption(args, "--scl")))
+        return fail("could not read Scala file " + getFileOption(args, "--scl").getFullPathName());
+
+    if (args.containsOption("--kbm") && ! processor->midiProcessor.loadKbmFile(getFileOption(args, "--kbm")))
+        return fail("could not read keyboard mapping " + getFileOption(args, "--kbm").getFullPathName());
+
+    if (args.containsOption("--formants"))
+    {
+        juce::String error;
+
+        if (! processor->loadFormantLibrary(getFileOption(args, "--formants"), error))
+            return fail("could not read formant library " + getFileOption(args, "--formants").getFullPathName() + ": " + error);
+    }
+
+    if (savesPreset)
+    {
+        const auto presetFile = getFileOption(args, "--save-preset");
+        juce::MemoryBlock state;
+        processor->getStateInformation(state);
+
+        if (! presetFile.replaceWithData(state.getData(), state.getSize()))
+            return fail("could not write " + presetFile.getFullPathName());
+
+        std::cout << "Wrote preset " << presetFile.getFullPathName() << std::endl;
+
+        if (! renders)
+            return 0;
+    }
+
+    juce::MidiMessageSequence sequence;
+    const auto midiFile = getFileOption(args, "--midi");
+
+    if (! loadMidiFile(midiFile, sequence))
+        return fail("could not read MIDI file " + midiFile.getFullPathName());
+
+    processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor->prepareToPlay(sampleRate, blockSize);
+
+    // Offline there's no reason to start on the analytic pulse
+    juce::SharedResourcePointer<GlottalWavetableCache> wavetableCache;
+    wavetableCache->waitUntilBuilt(30000);
+
+    // Program changes in the file switch between blocks, to a preset or a
+    // library scale, so both collections have to be read in first
+    juce::SharedResourcePointer<PresetBank> presetBank;
+    juce::SharedResourcePointer<ScaleLibrary> scaleLibrary;
+    presetBank->waitForScan(30000);
+    scaleLibrary->waitForScan(30000);
+
+    const int numChannels = processor->getTotalNumOutputChannels();
+    const auto outFile = getFileOption(args, "--out");
+    outFile.deleteFile();
+
+    std::unique_ptr<juce::FileOutputStream> outStream(outFile.createOutputStream());
+
+    if (outStream == nullptr)
+        return fail("could not create " + outFile.getFullPathName());
+
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(outStream.get(), sampleRate,
+                                                                        static_cast<unsigned int>(numChannels),
+                                                                        bitDepth, {}, 0));
+
+    if (writer == nullptr)
+        return fail("unsupported WAV format");
+
+    outStream.release(); // now owned by the writer
+
+    const auto lastEventTime = sequence.getNumEvents() > 0 ? sequence.getEndTime() : 0.0;
+    const auto totalSamples = static_cast<juce::int64>(std::ceil((lastEventTime + tailSeconds) * sampleRate));
+
+    // The decimator's delay is rendered past the end and dropped from the
+    // start, so the file lines up with the MIDI
+    const int latency = processor->getLatencySamples();
+    juce::int64 samplesToSkip = latency;
+
+    std::cout << "Rendering " << midiFile.getFileName() << " (" << sequence.getNumEvents() << " events, "
+              << juce::String((lastEventTime + tailSeconds) / 60.0, 1) << " min) at " << sampleRate
+              << " Hz, " << blockSize << " samples/block" << std::endl;
+
+    juce::AudioBuffer<float> buffer(numChannels, blockSize);
+    juce::MidiBuffer midi;
+    int nextEvent = 0;
+    int lastReportedPercent = -1;
+
+    const double startTime = juce::Time::getMillisecondCounterHiRes();
+
+    for (juce::int64 position = 0; position < totalSamples + latency; position += blockSize)
+    {
+        const int numSamples = static_cast<int>(juce::jmin(static_cast<juce::int64>(blockSize), totalSamples + latency - position));
+        const auto blockEnd = position + numSamples;
+
+        midi.clear();
+
+        while (nextEvent < sequence.getNumEvents())
+        {
+            const auto& message = sequence.getEventPointer(nextEvent)->message;
+            const auto eventSample = static_cast<juce::int64>(std::round(message.getTimeStamp() * sampleRate));
+
+            if (eventSample >= blockEnd)
+                break;
+
+            if (! message.isMetaEvent())
+                midi.addEvent(message, static_cast<int>(juce::jmax(static_cast<juce::int64>(0), eventSample - position)));
+
+            ++nextEvent;
+        }
+
+        buffer.setSize(numChannels, numSamples, false, false, true);
+        buffer.clear();
+        processor->processBlock(buffer, midi);
+
+        const int skipped = static_cast<int>(juce::jmin(samplesToSkip, static_cast<juce::int64>(numSamples)));
+        samplesToSkip -= skipped;
+
+        if (skipped < numSamples && ! writer->writeFromAudioSampleBuffer(buffer, skipped, numSamples - skipped))
+            return fail("write failed, disk full?");
+
+        const int percent = static_cast<int>(juce::jmin(static_cast<juce::int64>(100), 100 * blockEnd / totalSamples));
+
+        if (percent / 10 != lastReportedPercent / 10)
+        {
+            std::cout << "  " << percent << "%" << std::endl;
+            lastReportedPercent = percent;
+        }
+    }
+
+    writer.reset();
+    processor->releaseResources();
+
+    const double elapsedSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    const double renderedSeconds = static_cast<double>(totalSamples) / sampleRate;
+
+    std::cout << "Wrote " << outFile.getFullPathName() << std::endl
+              << "  audio:           " << juce::String(renderedSeconds, 2) << " s" << std::endl
+              << "  wall clock:      " << juce::String(elapsedSeconds, 2) << " s" << std::endl
+              << "  real-time factor:" << juce::String(renderedSeconds / juce::jmax(elapsedSeconds, 1.0e-9), 1) << "x" << std::endl
+              << "  peak memory:     " << juce::String(static_cast<double>(getPeakMemoryBytes()) / (1024.0 * 1024.0), 1)
+              << " MB" << std::endl;
+
+    return 0;
+}
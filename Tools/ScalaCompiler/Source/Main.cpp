@@ -0,0 +1,239 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 18 Oct 2026 3:41:52am
+    Author:  zerocase
+
+    Batch converter from Scala text files to compiled tuning archives: walks
+    a directory for .scl and .kbm files and writes them all to one archive,
+    or one archive per file. Files that don't parse are reported and left out.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/Data/TuningArchive.h"
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "usage: ISODRONEScalaCompiler <directory> (--out <file.isotun> | --out-dir <directory>)" << std::endl
+                  << std::endl
+                  << "  --out <file>       write every scale and mapping to one archive" << std::endl
+                  << "  --out-dir <dir>    write one archive per file, mirroring the directory tree" << std::endl
+                  << "  --verify           reload what was written and compare it with the text" << std::endl;
+    }
+
+    int fail(const juce::String& message)
+    {
+        std::cerr << "error: " << message << std::endl;
+        return 1;
+    }
+
+    struct SourceFile
+    {
+        juce::File file;
+        juce::String name;          // Relative path without extension
+        bool isScale;
+        scala::scale scale;
+        scala::kbm mapping;
+    };
+
+    // Parses the file straight out of its mapping
+    bool parse(SourceFile& source, juce::String& error)
+    {
+        juce::MemoryMappedFile mapped(source.file, juce::MemoryMappedFile::readOnly);
+
+        if (mapped.getData() == nullptr)
+        {
+            error = source.file.getSize() == 0 ? "empty file" : "could not open";
+            return false;
+        }
+
+        const auto* text = static_cast<const char*>(mapped.getData());
+
+        try
+        {
+            if (source.isScale)
+                source.scale = scala::read_scl(text, mapped.getSize());
+            else
+                source.mapping = scala::read_kbm(text, mapped.getSize());
+        }
+        catch (const std::exception& e)
+        {
+            error = e.what();
+            return false;
+        }
+
+        return true;
+    }
+
+    void add(TuningArchive::Builder& builder, const SourceFile& source)
+    {
+        if (source.isScale)
+            builder.addScale(source.name, source.scale);
+        else
+            builder.addKeyboardMapping(source.name, source.mapping);
+    }
+
+    bool matches(const TuningArchive& archive, int entry, const SourceFile& source)
+    {
+        if (source.isScale)
+        {
+            if (archive.getKind(entry) != TuningArchive::Kind::scale)
+                return false;
+
+            const auto compiled = archive.getScale(entry);
+
+            if (compiled.degrees.size() != source.scale.degrees.size())
+                return false;
+
+            for (size_t d = 0; d < compiled.degrees.size(); ++d)
+                if (compiled.degrees[d].get_ratio() != source.scale.degrees[d].get_ratio())
+                    return false;
+
+            return true;
+        }
+
+        if (archive.getKind(entry) != TuningArchive::Kind::keyboardMapping)
+            return false;
+
+        const auto compiled = archive.getKeyboardMapping(entry);
+        const auto& original = source.mapping;
+
+        return compiled.mapping == original.mapping && compiled.map_size == original.map_size
+            && compiled.first_note == original.first_note && compiled.last_note == original.last_note
+            && compiled.middle_note == original.middle_note && compiled.reference_note == original.reference_note
+            && compiled.reference_frequency == original.reference_frequency
+            && compiled.octave_degree == original.octave_degree;
+    }
+
+    // Loads an archive and checks its entries, in order, against the sources
+    bool verify(const juce::File& file, const SourceFile* sources, int numSources)
+    {
+        juce::String error;
+        const auto archive = TuningArchive::loadFromFile(file, error);
+
+        if (archive == nullptr || archive->getNumEntries() != numSources)
+        {
+            std::cerr << "  " << file.getFullPathName() << ": " << (archive == nullptr ? error : "wrong entry count") << std::endl;
+            return false;
+        }
+
+        for (int s = 0; s < numSources; ++s)
+        {
+            if (! matches(*archive, s, sources[s]))
+            {
+                std::cerr << "  " << file.getFullPathName() << ": " << sources[s].name << " differs" << std::endl;
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h") || args.size() < 3
+        || args.containsOption("--out") == args.containsOption("--out-dir"))
+    {
+        printUsage();
+        return args.containsOption("--help|-h") ? 0 : 1;
+    }
+
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+    const auto inputDirectory = cwd.getChildFile(args[0].text);
+
+    if (! inputDirectory.isDirectory())
+        return fail(inputDirectory.getFullPathName() + " is not a directory");
+
+    auto files = inputDirectory.findChildFiles(juce::File::findFiles, true, "*.scl;*.kbm");
+    std::sort(files.begin(), files.end());
+
+    std::vector<SourceFile> sources;
+    sources.reserve(static_cast<size_t>(files.size()));
+    juce::int64 totalBytes = 0;
+    int failures = 0;
+
+    const double parseStart = juce::Time::getMillisecondCounterHiRes();
+
+    for (const auto& file : files)
+    {
+        SourceFile source { file, file.getRelativePathFrom(inputDirectory).upToLastOccurrenceOf(".", false, false),
+                            file.hasFileExtension("scl"), {}, {} };
+        juce::String error;
+
+        if (! parse(source, error))
+        {
+            std::cerr << "  skipped " << file.getRelativePathFrom(inputDirectory) << ": " << error << std::endl;
+            ++failures;
+            continue;
+        }
+
+        totalBytes += file.getSize();
+        sources.push_back(std::move(source));
+    }
+
+    const double parseSeconds = (juce::Time::getMillisecondCounterHiRes() - parseStart) / 1000.0;
+
+    std::cout << "Parsed " << sources.size() << " of " << files.size() << " files ("
+              << juce::String(static_cast<double>(totalBytes) / (1024.0 * 1024.0), 2) << " MB) in "
+              << juce::String(parseSeconds * 1000.0, 1) << " ms, "
+              << juce::String(static_cast<double>(sources.size()) / juce::jmax(parseSeconds, 1.0e-9), 0) << " files/s"
+              << std::endl;
+
+    const bool shouldVerify = args.containsOption("--verify");
+    bool verified = true;
+
+    if (args.containsOption("--out"))
+    {
+        const auto outFile = cwd.getChildFile(args.getValueForOption("--out"));
+        TuningArchive::Builder builder;
+
+        for (const auto& source : sources)
+            add(builder, source);
+
+        if (! builder.writeTo(outFile))
+            return fail("could not write " + outFile.getFullPathName());
+
+        std::cout << "Wrote " << outFile.getFullPathName() << " (" << builder.getNumEntries() << " entries, "
+                  << juce::String(static_cast<double>(outFile.getSize()) / (1024.0 * 1024.0), 2) << " MB)" << std::endl;
+
+        if (shouldVerify)
+            verified = verify(outFile, sources.data(), static_cast<int>(sources.size()));
+    }
+    else
+    {
+        const auto outDirectory = cwd.getChildFile(args.getValueForOption("--out-dir"));
+
+        // foo.scl and foo.kbm can sit side by side, so keep the source extension
+        for (const auto& source : sources)
+        {
+            const auto outFile = outDirectory.getChildFile(source.file.getRelativePathFrom(inputDirectory)
+                                                           + TuningArchive::fileExtension);
+            TuningArchive::Builder builder;
+            add(builder, source);
+
+            if (! outFile.getParentDirectory().createDirectory() || ! builder.writeTo(outFile))
+                return fail("could not write " + outFile.getFullPathName());
+
+            if (shouldVerify)
+                verified = verify(outFile, &source, 1) && verified;
+        }
+
+        std::cout << "Wrote " << sources.size() << " archives to " << outDirectory.getFullPathName() << std::endl;
+    }
+
+    if (shouldVerify)
+        std::cout << (verified ? "Verified" : "Verification FAILED") << std::endl;
+
+    if (failures > 0)
+        std::cout << failures << " files skipped" << std::endl;
+
+    return verified ? 0 : 1;
+}